@@ -472,6 +472,7 @@ install_apps() {
 	done
 }
 
+# single file push, one adb round trip per call - prefer stagetoAVD + pushstagetoAVD
 pushtoAVD() {
 	local SRC=""
 	local DST="$2"
@@ -489,6 +490,47 @@ pushtoAVD() {
 	echo "[-] $ADBPUSHECHO"
 }
 
+# Instead of paying one adb round trip per file, collect everything that
+# needs to go to the AVD in a local staging dir first and send it in one go
+stagetoAVD() {
+	local SRC="$1"
+	local DST="$2"
+
+	if [[ "$STAGEDIR" == "" ]]; then
+		STAGEDIR=$(mktemp -d "${TMPDIR:-/tmp}/rootAVD-stage.XXXXXX")
+	fi
+
+	if [[ "$DST" == "" ]]; then
+		echo "[*] Stage ${SRC##*/} for a single push"
+		cp -a $SRC "$STAGEDIR/" 2>/dev/null
+	else
+		echo "[*] Stage ${SRC##*/} as $DST for a single push"
+		cp -a "$SRC" "$STAGEDIR/$DST" 2>/dev/null
+	fi
+}
+
+# Stream the whole staging dir as one tar archive through a single adb
+# connection and extract it on-device; fall back to one directory push
+# if the AVD side has no usable tar
+pushstagetoAVD() {
+	local ADBPUSHECHO=""
+
+	if [[ "$STAGEDIR" == "" ]]; then
+		return 0
+	fi
+
+	echo "[-] Push all staged files into $ADBBASEDIR in one go"
+	(cd "$STAGEDIR" && tar -cf - .) | adb shell "tar -xf - -C $ADBBASEDIR" 2>/dev/null
+	if [ "$?" != "0" ]; then
+		echo "[!] On-Device tar extract failed, falling back to a directory push"
+		ADBPUSHECHO=$(adb push "$STAGEDIR/." $ADBBASEDIR 2>/dev/null)
+		echo "[-] $ADBPUSHECHO"
+	fi
+
+	rm -rf "$STAGEDIR"
+	STAGEDIR=""
+}
+
 pullfromAVD() {
 	local SRC=""
 	local DST=""
@@ -754,6 +796,7 @@ CopyMagiskToAVD() {
 	fi
 
 	ADBBASEDIR=$ADBWORKDIR/Magisk
+	STAGEDIR=""
 	echo "[-] In any AVD via ADB, you can execute code without root in $ADBWORKDIR"
 
 	echo "[*] Cleaning up the ADB working space"
@@ -765,7 +808,7 @@ CopyMagiskToAVD() {
 	# If Magisk.zip file doesn't exist, just ignore it
 	if ( ! checkfile "$MAGISKZIP" -eq 0 ); then
 		echo "[-] Magisk installer Zip exists already"
-		pushtoAVD "$MAGISKZIP"
+		stagetoAVD "$MAGISKZIP"
 	fi
 
 	# Proceed with ramdisk
@@ -777,29 +820,31 @@ CopyMagiskToAVD() {
 		fi
 
 		create_backup "$AVDPATHWITHRDFFILE"
-		pushtoAVD "$AVDPATHWITHRDFFILE" "ramdisk.img"
+		stagetoAVD "$AVDPATHWITHRDFFILE" "ramdisk.img"
 
 		if ( "$InstallKernelModules" ); then
 			INITRAMFS=$ROOTAVD/initramfs.img
 			if ( ! checkfile "$INITRAMFS" -eq 0 ); then
-				pushtoAVD "$INITRAMFS"
+				stagetoAVD "$INITRAMFS"
 			fi
 		fi
 
 		if ( "$AddRCscripts" ); then
 			for f in $ROOTAVD/*.rc; do
-				pushtoAVD "$f"
+				stagetoAVD "$f"
 			done
-			pushtoAVD "$ROOTAVD/sbin"
+			stagetoAVD "$ROOTAVD/sbin"
 		fi
 	fi
 
-	pushtoAVD "rootAVD.sh"
+	stagetoAVD "rootAVD.sh"
 
 	if ( "$UpdateBusyBoxScript" ); then
-		pushtoAVD "libbusybox*.so"
+		stagetoAVD "libbusybox*.so"
 	fi
 
+	pushstagetoAVD
+
 	echo "[-] run the actually Boot/Ramdisk/Kernel Image Patch Script"
 	echo "[*] from Magisk by topjohnwu and modded by NewBit XDA"
 
@@ -938,6 +983,71 @@ DownLoadFile() {
 	fi
 }
 
+# Checksum validated download cache, shared across runs.
+# Payloads live under /sdcard/Download keyed by the md5 of their URL, so a
+# re-run with a warm cache performs no network I/O at all; interrupted
+# downloads keep their .part file and resume with wget -c instead of
+# starting over from zero
+DLCACHEDIR=/sdcard/Download/.rootAVD_dlcache
+
+CachedDownLoadFile() {
+	local URL="$1"
+	local DST="$2"
+	local KEY=""
+	local CF=""
+	local SUMF=""
+	local RESULT=""
+	local FSIZE=""
+	local COUNT=""
+	local BS=1024
+	local CUTOFF=100
+
+	KEY=$(echo -n "$URL" | $BB md5sum | $BB cut -d' ' -f1)
+	CF=$DLCACHEDIR/$KEY
+	SUMF=$CF.md5
+	mkdir -p $DLCACHEDIR 2>/dev/null
+
+	if [ -e "$CF" ] && [ -e "$SUMF" ]; then
+		if [ "$($BB md5sum < $CF | $BB cut -d' ' -f1)" == "$(cat $SUMF)" ]; then
+			echo "[-] Cache hit for ${URL##*/}, skipping download"
+			cp -f "$CF" "$DST"
+			return 0
+		fi
+		echo "[!] Cached ${URL##*/} failed its checksum, downloading again"
+		rm -f "$CF" "$SUMF"
+	fi
+
+	CheckAVDIsOnline
+	("$AVDIsOnline") || return 1
+
+	if [ -e "$CF.part" ]; then
+		echo "[-] Resuming interrupted download of ${URL##*/}"
+	fi
+	$BB wget -q -O "$CF.part" --no-check-certificate "$URL" -c
+	RESULT="$?"
+	while [ $RESULT != "0" ]
+	do
+		echo "[!] Error while downloading File ${URL##*/}"
+		echo "[-] patching it together"
+		FSIZE=$(./busybox stat $CF.part -c %s)
+		if [ $FSIZE -gt $BS ]; then
+			COUNT=$(( FSIZE/BS ))
+			if [ $COUNT -gt $CUTOFF ]; then
+				COUNT=$(( COUNT - $CUTOFF ))
+			fi
+		fi
+		$BB dd if=$CF.part count=$COUNT bs=$BS of=$CF.tmp > /dev/null 2>&1
+		mv -f $CF.tmp $CF.part
+		$BB wget -q -O "$CF.part" --no-check-certificate "$URL" -c
+		RESULT="$?"
+	done
+	mv -f "$CF.part" "$CF"
+	$BB md5sum < "$CF" | $BB cut -d' ' -f1 > "$SUMF"
+	cp -f "$CF" "$DST"
+	echo "[!] Downloading File ${URL##*/} complete!"
+	return 0
+}
+
 GetUSBHPmod() {
 	USBHPZSDDL="/sdcard/Download"
 	USBHPZ="https://gitlab.com/newbit/usbhostpermissions/-/releases/permalink/latest/downloads/usbhostpermissions"
@@ -1112,23 +1222,7 @@ CheckAvailableMagisks() {
 			rm -rf $MZ
 			rm -rf *.apk
 			echo "[*] Downloading Magisk $MAGISK_CNL $MAGISK_VER"
-			$BB wget -q -O $MZ --no-check-certificate $MAGISK_DL
-			RESULT="$?"
-			while [ $RESULT != "0" ]; do
-				echo "[!] Error while downloading Magisk $MAGISK_CNL $MAGISK_VER"
-				echo "[-] patching it together"
-				FSIZE=$(./busybox stat $MZ -c %s)
-				if [ $FSIZE -gt $BS ]; then
-					COUNT=$(( FSIZE/BS ))
-					if [ $COUNT -gt $CUTOFF ]; then
-						COUNT=$(( COUNT - $CUTOFF ))
-					fi
-				fi
-				$BB dd if=$MZ count=$COUNT bs=$BS of=$OF > /dev/null 2>&1
-				mv -f $OF $MZ
-				$BB wget -q -O $MZ --no-check-certificate $MAGISK_DL -c
-				RESULT="$?"
-			done
+			CachedDownLoadFile "$MAGISK_DL" "$MZ"
 			echo "[!] Downloading Magisk $MAGISK_CNL $MAGISK_VER complete!"
 			MAGISKVERCHOOSEN=true
 			PrepBusyBoxAndMagisk
@@ -1936,10 +2030,12 @@ update_lib_modules() {
 			done
 
 			echo "[-] Downloading Kernel and its Modules..."
+			# Both archives are addressed by their commit id, so they never
+			# change and can be served from the download cache
 			# Download Kernel
-			DownLoadFile "$URL/kernel/prebuilts/$majmin/$KERNEL_ARCH/+archive/" $KERCOMMITID $KERDST
+			CachedDownLoadFile "$URL/kernel/prebuilts/$majmin/$KERNEL_ARCH/+archive/$KERCOMMITID" "$BASEDIR/$KERDST"
 			# Download Modules
-			DownLoadFile "$URL/kernel/prebuilts/common-modules/virtual-device/$majmin/$KERNEL_ARCH/+archive/" $MODCOMMITID $MODDST
+			CachedDownLoadFile "$URL/kernel/prebuilts/common-modules/virtual-device/$majmin/$KERNEL_ARCH/+archive/$MODCOMMITID" "$BASEDIR/$MODDST"
 
 			echo "[*] Extracting kernel-$majmin to bzImage"
 			tar -xf $KERDST kernel-$majmin -O > bzImage
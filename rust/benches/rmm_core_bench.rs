@@ -0,0 +1,181 @@
+//! RmmCore 热路径基准测试
+//!
+//! 运行方式: cargo bench
+//! 保存基线: cargo bench -- --save-baseline main
+//! 对比回归: cargo bench -- --baseline main
+//!
+//! 覆盖 scan_projects（10/100/1000 项目，浅/深目录树）、get_meta_config
+//! 的缓存命中路径、get_git_info 以及完整构建流水线
+
+use criterion::{criterion_group, criterion_main, BenchmarkId, Criterion};
+use std::collections::HashMap;
+use std::fs;
+use std::path::Path;
+use tempfile::TempDir;
+
+use rmmcore::cmds::build::{build_project_with, BuildOptions};
+use rmmcore::core::RmmCore;
+
+/// 在指定目录下生成一个最小的有效 RMM 项目
+fn make_project(dir: &Path, id: &str) {
+    let project = dir.join(id);
+    fs::create_dir_all(project.join(".rmmp")).unwrap();
+    fs::write(
+        project.join("rmmproject.toml"),
+        format!(
+            "[project]\nid = \"{}\"\ndescription = \"bench fixture\"\nreadme = \"README.MD\"\nchangelog = \"CHANGELOG.MD\"\nlicense = \"MIT\"\ndependencies = []\n\n[[authors]]\nname = \"bench\"\nemail = \"bench@example.com\"\n",
+            id
+        ),
+    )
+    .unwrap();
+    fs::write(
+        project.join(".rmmp/Rmake.toml"),
+        "[build]\ninclude = []\nexclude = []\nprebuild = []\nbuild = [\"default\"]\npostbuild = []\n",
+    )
+    .unwrap();
+    fs::write(
+        project.join("module.prop"),
+        format!(
+            "id={}\nname={}\nversion=v0.1.0\nversionCode=10000\nauthor=bench\ndescription=bench fixture\nupdateJson=\n",
+            id, id
+        ),
+    )
+    .unwrap();
+    fs::write(project.join("customize.sh"), "#!/system/bin/sh\ntrue\n").unwrap();
+}
+
+/// 生成含 N 个项目的扁平工作区
+fn make_workspace_flat(count: usize) -> TempDir {
+    let workspace = TempDir::new().unwrap();
+    for i in 0..count {
+        make_project(workspace.path(), &format!("proj{:04}", i));
+    }
+    workspace
+}
+
+/// 生成嵌套目录树工作区：项目分散在 depth 层深的目录里
+fn make_workspace_deep(count: usize, depth: usize) -> TempDir {
+    let workspace = TempDir::new().unwrap();
+    for i in 0..count {
+        let mut dir = workspace.path().to_path_buf();
+        for level in 0..depth {
+            dir = dir.join(format!("level{}_{}", level, i % 4));
+        }
+        make_project(&dir, &format!("proj{:04}", i));
+    }
+    workspace
+}
+
+/// 隔离的 RMM_ROOT，避免基准读写真实配置
+fn setup_rmm_root() -> (TempDir, RmmCore) {
+    let root = TempDir::new().unwrap();
+    unsafe {
+        std::env::set_var("RMM_ROOT", root.path());
+    }
+    let core = RmmCore::new();
+    (root, core)
+}
+
+fn bench_scan_projects(c: &mut Criterion) {
+    let (_root, core) = setup_rmm_root();
+    let mut group = c.benchmark_group("scan_projects");
+
+    for &count in &[10usize, 100, 1000] {
+        let workspace = make_workspace_flat(count);
+        group.sample_size(10);
+        group.bench_with_input(BenchmarkId::new("flat", count), &count, |b, _| {
+            b.iter(|| core.scan_projects(workspace.path(), Some(3)).unwrap())
+        });
+    }
+
+    for &count in &[10usize, 100] {
+        let workspace = make_workspace_deep(count, 4);
+        group.bench_with_input(BenchmarkId::new("deep", count), &count, |b, _| {
+            b.iter(|| core.scan_projects(workspace.path(), Some(8)).unwrap())
+        });
+    }
+
+    group.finish();
+}
+
+fn bench_get_meta_config(c: &mut Criterion) {
+    let (_root, core) = setup_rmm_root();
+    let mut projects = HashMap::new();
+    for i in 0..100 {
+        projects.insert(format!("proj{:04}", i), format!("/tmp/proj{:04}", i));
+    }
+    let mut meta = core.create_default_meta("bench@example.com", "bench", "0.1.0");
+    meta.projects = projects;
+    core.update_meta_config(&meta).unwrap();
+
+    // 稳态：内存缓存命中
+    c.bench_function("get_meta_config/cached", |b| {
+        b.iter(|| core.get_meta_config().unwrap())
+    });
+
+    // 冷路径：每次清空缓存，走持久化缓存/TOML 解析
+    c.bench_function("get_meta_config/cold", |b| {
+        b.iter(|| {
+            core.clear_cache();
+            core.get_meta_config().unwrap()
+        })
+    });
+}
+
+fn bench_get_git_info(c: &mut Criterion) {
+    let (_root, core) = setup_rmm_root();
+    let workspace = TempDir::new().unwrap();
+    make_project(workspace.path(), "gitproj");
+    let project = workspace.path().join("gitproj");
+
+    // 初始化一个带提交的仓库
+    let repo = git2::Repository::init(&project).unwrap();
+    {
+        let mut index = repo.index().unwrap();
+        index
+            .add_all(["*"].iter(), git2::IndexAddOption::DEFAULT, None)
+            .unwrap();
+        index.write().unwrap();
+        let tree_id = index.write_tree().unwrap();
+        let tree = repo.find_tree(tree_id).unwrap();
+        let sig = git2::Signature::now("bench", "bench@example.com").unwrap();
+        repo.commit(Some("HEAD"), &sig, &sig, "init", &tree, &[]).unwrap();
+    }
+
+    c.bench_function("get_git_info", |b| {
+        b.iter(|| core.get_git_info(&project).unwrap())
+    });
+}
+
+fn bench_build_pipeline(c: &mut Criterion) {
+    let (_root, _core) = setup_rmm_root();
+    let workspace = TempDir::new().unwrap();
+    make_project(workspace.path(), "buildproj");
+    let project = workspace.path().join("buildproj");
+    // 无 .sh 依赖 shellcheck 的路径：去掉脚本，基准聚焦复制+打包
+    fs::remove_file(project.join("customize.sh")).unwrap();
+
+    let mut group = c.benchmark_group("build_pipeline");
+    group.sample_size(10);
+
+    group.bench_function("full", |b| {
+        let options = BuildOptions::default();
+        b.iter(|| build_project_with(&project, &options).unwrap())
+    });
+
+    group.bench_function("incremental_noop", |b| {
+        let options = BuildOptions { incremental: true, ..Default::default() };
+        b.iter(|| build_project_with(&project, &options).unwrap())
+    });
+
+    group.finish();
+}
+
+criterion_group!(
+    benches,
+    bench_scan_projects,
+    bench_get_meta_config,
+    bench_get_git_info,
+    bench_build_pipeline
+);
+criterion_main!(benches);
@@ -2,6 +2,7 @@ use anyhow::Result;
 use chrono;
 use colored::Colorize;
 use serde::{Deserialize, Serialize};
+use std::collections::HashMap;
 use std::fs;
 use std::path::{Path, PathBuf};
 use std::process::Command;
@@ -49,38 +50,604 @@ struct ShellcheckReport {
     issues: Vec<ShellcheckIssue>,
 }
 
+/// shellcheck 结果缓存条目，按文件内容哈希命中（.rmmp/shellcheck-cache.json）
+#[derive(Debug, Serialize, Deserialize, Clone)]
+struct ShellcheckCacheEntry {
+    content_hash: u32,
+    issues: Vec<ShellcheckIssue>,
+    fixes_diff: String,
+}
+
+/// 一次批量 shellcheck 调用的输出
+struct ShellcheckBatchOutput {
+    issues: Vec<ShellcheckIssue>,
+    wiki_text: String,
+    fixes_diff: String,
+}
+
+/// 对一批脚本执行 shellcheck（一次进程调用检查多个文件）
+fn run_shellcheck_batch(batch: &[PathBuf]) -> Result<ShellcheckBatchOutput> {
+    // 使用 JSON 格式输出获取详细信息
+    let json_output = Command::new("shellcheck")
+        .arg("--format=json")
+        .args(batch)
+        .output()?;
+
+    // 获取带 wiki 链接的详细输出
+    let wiki_output = Command::new("shellcheck")
+        .arg("-W")
+        .arg("10") // 显示最多10个wiki链接
+        .args(batch)
+        .output()?;
+
+    // 获取 diff 格式的修复建议
+    let diff_output = Command::new("shellcheck")
+        .arg("--format=diff")
+        .args(batch)
+        .output()?;
+
+    let issues = if json_output.stdout.is_empty() {
+        Vec::new()
+    } else {
+        serde_json::from_str::<Vec<ShellcheckIssue>>(&String::from_utf8_lossy(&json_output.stdout))
+            .unwrap_or_default()
+    };
+
+    Ok(ShellcheckBatchOutput {
+        issues,
+        wiki_text: String::from_utf8_lossy(&wiki_output.stdout).to_string(),
+        fixes_diff: String::from_utf8_lossy(&diff_output.stdout).to_string(),
+    })
+}
+
+/// 按 `--- a/<path>` 头把批量 diff 输出拆分到各个文件
+fn split_diff_by_file(diff: &str) -> HashMap<String, String> {
+    let mut result: HashMap<String, String> = HashMap::new();
+    let mut current_file: Option<String> = None;
+
+    for line in diff.lines() {
+        if let Some(path) = line.strip_prefix("--- a/") {
+            current_file = Some(path.trim().to_string());
+        }
+        if let Some(file) = &current_file {
+            let entry = result.entry(file.clone()).or_default();
+            entry.push_str(line);
+            entry.push('\n');
+        }
+    }
+
+    result
+}
+
+/// 构建选项
+#[derive(Debug, Clone, Default)]
+pub struct BuildOptions {
+    /// 启用 shellcheck 自动修复
+    pub auto_fix: bool,
+    /// 启用增量构建（基于内容哈希清单）
+    pub incremental: bool,
+    /// 流式打包：直接从源文件写 zip，跳过 .rmmp/build 暂存树
+    pub streaming: bool,
+    /// 输出各流水线阶段的耗时报告（并导出 chrome-trace JSON）
+    pub timings: bool,
+}
+
+/// --timings 的阶段计时器：记录每个流水线阶段的墙钟耗时，
+/// 结束时输出报告并导出 chrome://tracing 可加载的 JSON
+struct StageTimer {
+    enabled: bool,
+    start: std::time::Instant,
+    /// (阶段名, 相对起点的偏移, 耗时)
+    stages: Vec<(String, std::time::Duration, std::time::Duration)>,
+}
+
+impl StageTimer {
+    fn new(enabled: bool) -> Self {
+        Self { enabled, start: std::time::Instant::now(), stages: Vec::new() }
+    }
+
+    /// 包裹一个阶段执行并记录耗时（未启用时零开销直通）
+    fn stage<T>(&mut self, name: &str, f: impl FnOnce() -> Result<T>) -> Result<T> {
+        if !self.enabled {
+            return f();
+        }
+        let offset = self.start.elapsed();
+        let begin = std::time::Instant::now();
+        let out = f()?;
+        self.stages.push((name.to_string(), offset, begin.elapsed()));
+        Ok(out)
+    }
+
+    /// 输出耗时报告并写出 chrome-trace 文件到 .rmmp/build-trace.json
+    fn report(&self, project_path: &Path) {
+        if !self.enabled || self.stages.is_empty() {
+            return;
+        }
+
+        let total: std::time::Duration = self.stages.iter().map(|(_, _, d)| *d).sum();
+        println!("\n{}", "⏱️  构建阶段耗时".cyan().bold());
+        for (name, _, duration) in &self.stages {
+            let percent = duration.as_secs_f64() / total.as_secs_f64().max(f64::EPSILON) * 100.0;
+            println!("    {:<24} {:>10.2?}  {:>5.1}%", name, duration, percent);
+        }
+        println!("    {:<24} {:>10.2?}", "总计", total);
+
+        // 附带暂存树的文件数/字节数，方便把耗时和数据量对上
+        let build_dir = project_path.join(".rmmp/build");
+        if build_dir.exists() {
+            let (files, bytes) = walkdir::WalkDir::new(&build_dir)
+                .into_iter()
+                .filter_map(|e| e.ok())
+                .filter(|e| e.file_type().is_file())
+                .fold((0usize, 0u64), |(f, b), e| {
+                    (f + 1, b + e.metadata().map(|m| m.len()).unwrap_or(0))
+                });
+            println!("    暂存树: {} 个文件, {} 字节", files, bytes);
+        }
+
+        // chrome://tracing / Perfetto 可直接加载
+        let events: Vec<serde_json::Value> = self
+            .stages
+            .iter()
+            .map(|(name, offset, duration)| {
+                serde_json::json!({
+                    "name": name,
+                    "ph": "X",
+                    "ts": offset.as_micros() as u64,
+                    "dur": duration.as_micros() as u64,
+                    "pid": 1,
+                    "tid": 1,
+                })
+            })
+            .collect();
+        let trace_path = project_path.join(".rmmp/build-trace.json");
+        if let Ok(content) = serde_json::to_string_pretty(&events) {
+            if fs::write(&trace_path, content).is_ok() {
+                println!("    trace 已导出: {}", trace_path.display());
+            }
+        }
+    }
+}
+
+/// 每个文件的内容哈希清单，持久化在 .rmmp/build.manifest.json
+/// 键为相对项目根目录的路径，值为文件内容的 CRC32
+#[derive(Debug, Serialize, Deserialize, Default, PartialEq)]
+struct BuildManifest {
+    files: std::collections::BTreeMap<String, u32>,
+    /// Rmake.toml 内容的 CRC32：配置（压缩档位、pre/postbuild 脚本等）
+    /// 变化时增量跳过同样失效，不会用旧配置的产物蒙混过关
+    #[serde(default)]
+    config_crc: u32,
+}
+
 /// 构建模块项目
+/// 构建 meta.toml 中注册的所有项目（rmm build --all）：
+/// 单次进程启动，复用同一个 RmmCore 实例读取项目清单，
+/// 在一个有界 rayon 线程池里并发调度各项目的构建，
+/// 总耗时趋近于最慢的单个模块
+pub fn build_all_projects(options: &BuildOptions, jobs: Option<usize>) -> Result<()> {
+    use anyhow::Context;
+    use rayon::prelude::*;
+
+    let core = crate::core::rmm_core::RmmCore::new();
+    let meta = core.get_meta_config()
+        .with_context(|| "无法读取 meta.toml，请先运行 rmm sync 注册项目")?;
+
+    if meta.projects.is_empty() {
+        println!("{} meta.toml 中没有注册任何项目", "[!]".yellow().bold());
+        return Ok(());
+    }
+
+    let mut projects: Vec<(String, PathBuf)> = meta.projects.iter()
+        .map(|(name, path)| (name.clone(), PathBuf::from(path)))
+        .collect();
+    projects.sort_by(|a, b| a.0.cmp(&b.0));
+
+    // 提前剔除无效项目，避免 worker 里才失败
+    projects.retain(|(name, path)| {
+        if is_valid_project(path) {
+            true
+        } else {
+            println!("{} 跳过无效项目 {}（{}）", "[!]".yellow().bold(), name.cyan().bold(), path.display());
+            false
+        }
+    });
+
+    if projects.is_empty() {
+        println!("{} 没有可构建的有效项目", "[!]".yellow().bold());
+        return Ok(());
+    }
+
+    let worker_count = jobs
+        .unwrap_or_else(|| rayon::current_num_threads())
+        .clamp(1, projects.len());
+    println!("{} 批量构建 {} 个项目（{} 个并发任务）",
+        "🔨".blue().bold(), projects.len(), worker_count);
+
+    let pool = rayon::ThreadPoolBuilder::new()
+        .num_threads(worker_count)
+        .build()
+        .with_context(|| "无法创建构建线程池")?;
+
+    let total_start = std::time::Instant::now();
+    let results: Vec<(String, Result<std::time::Duration>)> = pool.install(|| {
+        projects.par_iter()
+            .map(|(name, path)| {
+                println!("{} [{}] 开始构建", "🚧".blue(), name.cyan().bold());
+                let start = std::time::Instant::now();
+                let result = build_project_with(path, options).map(|_| start.elapsed());
+                match &result {
+                    Ok(elapsed) => println!("{} [{}] 构建完成（{:.2?}）", "✅".green(), name.cyan().bold(), elapsed),
+                    Err(e) => println!("{} [{}] 构建失败: {}", "❌".red(), name.cyan().bold(), e),
+                }
+                (name.clone(), result)
+            })
+            .collect()
+    });
+
+    let failed: Vec<&String> = results.iter()
+        .filter(|(_, result)| result.is_err())
+        .map(|(name, _)| name)
+        .collect();
+
+    println!();
+    println!("{} 批量构建结束：{} 成功 / {} 失败，总耗时 {:.2?}",
+        "📦".blue().bold(),
+        results.len() - failed.len(),
+        failed.len(),
+        total_start.elapsed());
+
+    if !failed.is_empty() {
+        anyhow::bail!("{} 个项目构建失败: {}", failed.len(),
+            failed.iter().map(|s| s.as_str()).collect::<Vec<_>>().join(", "));
+    }
+    Ok(())
+}
+
 pub fn build_project(project_path: &Path) -> Result<()> {
     build_project_with_options(project_path, true) // 默认启用自动修复
 }
 
 /// 构建模块项目（带选项）
 pub fn build_project_with_options(project_path: &Path, auto_fix: bool) -> Result<()> {
+    build_project_with(project_path, &BuildOptions { auto_fix, ..Default::default() })
+}
+
+/// 构建模块项目（完整选项）
+pub fn build_project_with(project_path: &Path, options: &BuildOptions) -> Result<()> {
     println!("{}", "🔨 开始构建模块项目".green().bold());
-    
+
     // 检查项目是否有效
     if !is_valid_project(project_path) {
         anyhow::bail!("当前目录不是有效的 RMM 项目");
     }
-    
+
+    let mut timer = StageTimer::new(options.timings);
+
     // 解析 Rmake.toml 配置
-    let rmake_config = load_rmake_config(project_path)?;
+    let rmake_config = timer.stage("解析配置", || load_rmake_config(project_path))?;
     println!("{} 解析构建配置", "[+]".green().bold());
-    
+
+    // 增量模式：先计算当前源文件的内容哈希清单，与上次构建对比
+    let incremental_manifest = if options.incremental {
+        let manifest = timer.stage("计算清单", || compute_build_manifest(project_path, &rmake_config))?;
+        let previous = load_build_manifest(project_path);
+
+        if let Some(previous) = &previous {
+            if *previous == manifest && output_zip_exists(project_path)? {
+                println!("{} 增量构建：源文件无变化，跳过构建", "[⚡]".green().bold());
+                return Ok(());
+            }
+        }
+
+        Some((manifest, previous))
+    } else {
+        None
+    };
+
+    // 流式打包模式：不物化暂存树，直接从源文件写 zip 条目
+    if options.streaming {
+        println!("{} 流式打包：跳过 .rmmp/build 暂存树", "[+]".green().bold());
+        fs::create_dir_all(project_path.join(".rmmp/dist"))?;
+
+        timer.stage("复制 update.json", || copy_update_json_to_dist(project_path))?;
+        timer.stage("shellcheck", || check_shell_scripts_streaming(project_path, &rmake_config, options.auto_fix))?;
+        timer.stage("prebuild", || execute_prebuild(project_path, &rmake_config))?;
+        timer.stage("流式打包", || package_module_streaming(project_path, &rmake_config))?;
+        timer.stage("postbuild", || execute_postbuild(project_path, &rmake_config))?;
+
+        if let Some((manifest, _)) = &incremental_manifest {
+            save_build_manifest(project_path, manifest)?;
+        }
+
+        // 执行源代码打包流程
+        timer.stage("源码打包", || execute_source_packaging(project_path, &rmake_config))?;
+
+        timer.report(project_path);
+        println!("\n{}", "🎉 模块构建完成！".green().bold());
+        return Ok(());
+    }
+
+    if let Some((manifest, previous)) = incremental_manifest {
+        // 有变化：只同步变化的文件到构建目录，然后重新打包
+        setup_build_directories_incremental(project_path)?;
+        timer.stage("增量同步", || sync_changed_files_to_build(project_path, &manifest, previous.as_ref()))?;
+        timer.stage("复制 update.json", || copy_update_json_to_dist(project_path))?;
+        timer.stage("shellcheck", || check_shell_scripts(project_path, &rmake_config, options.auto_fix))?;
+        timer.stage("prebuild", || execute_prebuild(project_path, &rmake_config))?;
+        timer.stage("打包模块", || package_module(project_path, &rmake_config))?;
+        timer.stage("postbuild", || execute_postbuild(project_path, &rmake_config))?;
+
+        // 打包成功后持久化新清单
+        save_build_manifest(project_path, &manifest)?;
+
+        // 执行源代码打包流程
+        timer.stage("源码打包", || execute_source_packaging(project_path, &rmake_config))?;
+
+        timer.report(project_path);
+        println!("\n{}", "🎉 模块构建完成！".green().bold());
+        return Ok(());
+    }
+
     // 创建构建目录
     setup_build_directories(project_path)?;
-    
+
     // 执行构建流程
-    execute_build_process(project_path, &rmake_config, auto_fix)?;
-    
+    execute_build_process(project_path, &rmake_config, options.auto_fix, &mut timer)?;
+
+    // 全量构建也刷新清单，让下一次增量构建有基线
+    if let Ok(manifest) = compute_build_manifest(project_path, &rmake_config) {
+        let _ = save_build_manifest(project_path, &manifest);
+    }
+
     // 执行源代码打包流程
-    execute_source_packaging(project_path, &rmake_config)?;
-    
+    timer.stage("源码打包", || execute_source_packaging(project_path, &rmake_config))?;
+
+    timer.report(project_path);
     println!("\n{}", "🎉 模块构建完成！".green().bold());
-    
+
     Ok(())
 }
 
+/// 清单文件路径
+fn build_manifest_path(project_path: &Path) -> PathBuf {
+    project_path.join(".rmmp/build.manifest.json")
+}
+
+/// 计算当前源文件的内容哈希清单（遵循 include/exclude 规则）
+///
+/// Rmake.toml 本身也记入清单：压缩配置、prebuild/postbuild 脚本等
+/// 只改配置不改条目集合的编辑同样会使增量跳过失效，触发重建。
+fn compute_build_manifest(project_path: &Path, rmake_config: &RmakeConfig) -> Result<BuildManifest> {
+    let mut manifest = BuildManifest::default();
+
+    // 配置哈希单独记录（不进 files，避免被增量同步复制进构建树）
+    let rmake_path = project_path.join(".rmmp/Rmake.toml");
+    if let Ok(content) = fs::read(&rmake_path) {
+        let mut crc = flate2::Crc::new();
+        crc.update(&content);
+        manifest.config_crc = crc.sum();
+    }
+
+    for entry in get_build_entries_quiet(project_path, rmake_config)? {
+        if entry.is_dir() {
+            for file in walkdir::WalkDir::new(&entry).into_iter().filter_map(|e| e.ok()) {
+                if file.file_type().is_file() {
+                    add_file_to_manifest(project_path, file.path(), &mut manifest)?;
+                }
+            }
+        } else {
+            add_file_to_manifest(project_path, &entry, &mut manifest)?;
+        }
+    }
+
+    Ok(manifest)
+}
+
+/// 将单个文件的 CRC32 记入清单
+fn add_file_to_manifest(project_path: &Path, file: &Path, manifest: &mut BuildManifest) -> Result<()> {
+    let relative = file.strip_prefix(project_path)?;
+    let key = relative.to_string_lossy().replace('\\', "/");
+    let content = fs::read(file)?;
+    let mut crc = flate2::Crc::new();
+    crc.update(&content);
+    manifest.files.insert(key, crc.sum());
+    Ok(())
+}
+
+/// 读取上次构建的清单（不存在或损坏时返回 None）
+fn load_build_manifest(project_path: &Path) -> Option<BuildManifest> {
+    let content = fs::read_to_string(build_manifest_path(project_path)).ok()?;
+    serde_json::from_str(&content).ok()
+}
+
+/// 持久化构建清单
+fn save_build_manifest(project_path: &Path, manifest: &BuildManifest) -> Result<()> {
+    let content = serde_json::to_string_pretty(manifest)?;
+    fs::write(build_manifest_path(project_path), content)?;
+    Ok(())
+}
+
+/// 检查目标 zip 是否已存在（无变化时跳过打包的前提）
+fn output_zip_exists(project_path: &Path) -> Result<bool> {
+    let project_info = read_project_info(project_path)?;
+    let module_name = format!("{}-{}.zip", project_info.id, project_info.version_code);
+    Ok(project_path.join(".rmmp/dist").join(module_name).exists())
+}
+
+/// 增量模式的目录准备：保留已有构建目录，只确保目录存在
+fn setup_build_directories_incremental(project_path: &Path) -> Result<()> {
+    fs::create_dir_all(project_path.join(".rmmp/build"))?;
+    fs::create_dir_all(project_path.join(".rmmp/dist"))?;
+    println!("{} 准备构建目录（增量）", "[+]".green().bold());
+    Ok(())
+}
+
+/// 只复制内容哈希发生变化的文件到构建目录，并清理已删除的文件
+fn sync_changed_files_to_build(
+    project_path: &Path,
+    manifest: &BuildManifest,
+    previous: Option<&BuildManifest>,
+) -> Result<()> {
+    let build_dir = project_path.join(".rmmp/build");
+    let mut copied = 0usize;
+    let mut removed = 0usize;
+
+    for (rel_path, crc) in &manifest.files {
+        let unchanged = previous
+            .map(|p| p.files.get(rel_path) == Some(crc))
+            .unwrap_or(false);
+        let dest_path = build_dir.join(rel_path);
+
+        if unchanged && dest_path.exists() {
+            continue;
+        }
+
+        if let Some(parent) = dest_path.parent() {
+            fs::create_dir_all(parent)?;
+        }
+        let src_path = project_path.join(rel_path);
+        if needs_line_ending_normalization(&src_path) {
+            copy_file_with_line_ending_normalization(&src_path, &dest_path)?;
+        } else {
+            fast_copy_file(&src_path, &dest_path)?;
+        }
+        copied += 1;
+    }
+
+    // 清理上次构建中存在、本次已被删除或排除的文件
+    if let Some(previous) = previous {
+        for rel_path in previous.files.keys() {
+            if !manifest.files.contains_key(rel_path) {
+                let stale = build_dir.join(rel_path);
+                if stale.exists() {
+                    fs::remove_file(&stale)?;
+                    removed += 1;
+                }
+            }
+        }
+    }
+
+    println!("{} 增量同步构建目录（复制 {} 个，清理 {} 个）", "[+]".green().bold(), copied, removed);
+    Ok(())
+}
+
+/// 监视模式：进程与解析后的配置常驻，文件变化时只重跑受影响的阶段
+///
+/// 轮询 mtime/size 戳记发现变化（git2/zip 等现有依赖不含 inotify 封装，
+/// 500ms 轮询对模块级目录树足够廉价），变化后走内容哈希清单做精确同步，
+/// 单文件修改的重打包目标是亚秒级
+pub fn watch_project(project_path: &Path, options: &BuildOptions) -> Result<()> {
+    println!("{}", "👀 进入监视构建模式（Ctrl+C 退出）".green().bold());
+
+    if !is_valid_project(project_path) {
+        anyhow::bail!("当前目录不是有效的 RMM 项目");
+    }
+
+    // 首次全量（增量）构建，建立清单基线
+    let watch_options = BuildOptions { incremental: true, ..options.clone() };
+    if let Err(e) = build_project_with(project_path, &watch_options) {
+        eprintln!("❌ 初始构建失败: {}", e);
+    }
+
+    let mut rmake_config = load_rmake_config(project_path)?;
+    let rmake_path = project_path.join(".rmmp/Rmake.toml");
+    let mut rmake_stamp = file_watch_stamp(&rmake_path);
+    let mut stamps = compute_watch_stamps(project_path, &rmake_config)?;
+
+    loop {
+        std::thread::sleep(std::time::Duration::from_millis(500));
+
+        // 配置变更：重新解析并全量重建
+        let new_rmake_stamp = file_watch_stamp(&rmake_path);
+        if new_rmake_stamp != rmake_stamp {
+            rmake_stamp = new_rmake_stamp;
+            println!("{} Rmake.toml 已修改，重新加载配置", "[~]".yellow().bold());
+            match load_rmake_config(project_path) {
+                Ok(config) => {
+                    rmake_config = config;
+                    if let Err(e) = build_project_with(project_path, &watch_options) {
+                        eprintln!("❌ 重建失败: {}", e);
+                    }
+                    stamps = compute_watch_stamps(project_path, &rmake_config)?;
+                }
+                Err(e) => eprintln!("⚠️  Rmake.toml 解析失败，沿用旧配置: {}", e),
+            }
+            continue;
+        }
+
+        let new_stamps = compute_watch_stamps(project_path, &rmake_config)?;
+        if new_stamps == stamps {
+            continue;
+        }
+        stamps = new_stamps;
+
+        // 源文件变化：只重跑 同步 → 打包，配置与进程保持常驻
+        let start = std::time::Instant::now();
+        let result = (|| -> Result<()> {
+            let manifest = compute_build_manifest(project_path, &rmake_config)?;
+            let previous = load_build_manifest(project_path);
+
+            if previous.as_ref() == Some(&manifest) {
+                return Ok(()); // mtime 变了但内容没变（如 touch）
+            }
+
+            if options.streaming {
+                package_module_streaming(project_path, &rmake_config)?;
+            } else {
+                setup_build_directories_incremental(project_path)?;
+                sync_changed_files_to_build(project_path, &manifest, previous.as_ref())?;
+                package_module(project_path, &rmake_config)?;
+            }
+            save_build_manifest(project_path, &manifest)?;
+            Ok(())
+        })();
+
+        match result {
+            Ok(()) => println!("{} 重建完成（{:.2?}）", "⚡".green().bold(), start.elapsed()),
+            Err(e) => eprintln!("❌ 重建失败: {}", e),
+        }
+    }
+}
+
+/// 单个文件的 (mtime纳秒, 大小) 戳记，文件不存在时返回 None
+fn file_watch_stamp(path: &Path) -> Option<(u128, u64)> {
+    let meta = fs::metadata(path).ok()?;
+    let mtime = meta
+        .modified()
+        .ok()?
+        .duration_since(std::time::UNIX_EPOCH)
+        .ok()?
+        .as_nanos();
+    Some((mtime, meta.len()))
+}
+
+/// 计算所有构建条目的戳记表，用于廉价的变化探测（不读文件内容）
+fn compute_watch_stamps(
+    project_path: &Path,
+    rmake_config: &RmakeConfig,
+) -> Result<std::collections::BTreeMap<String, (u128, u64)>> {
+    let mut stamps = std::collections::BTreeMap::new();
+
+    for entry in get_build_entries_quiet(project_path, rmake_config)? {
+        if entry.is_dir() {
+            for file in walkdir::WalkDir::new(&entry).into_iter().filter_map(|e| e.ok()) {
+                if file.file_type().is_file() {
+                    if let Some(stamp) = file_watch_stamp(file.path()) {
+                        let key = file.path().strip_prefix(project_path)?.to_string_lossy().replace('\\', "/");
+                        stamps.insert(key, stamp);
+                    }
+                }
+            }
+        } else if let Some(stamp) = file_watch_stamp(&entry) {
+            let key = entry.strip_prefix(project_path)?.to_string_lossy().replace('\\', "/");
+            stamps.insert(key, stamp);
+        }
+    }
+
+    Ok(stamps)
+}
+
 /// 检查是否是有效的项目
 fn is_valid_project(project_path: &Path) -> bool {
     project_path.join("module.prop").exists() 
@@ -121,53 +688,101 @@ fn execute_build_process(
     project_path: &Path,
     rmake_config: &RmakeConfig,
     auto_fix: bool,
+    timer: &mut StageTimer,
 ) -> Result<()> {
     // 1. 复制文件到构建目录
-    copy_files_to_build(project_path, rmake_config)?;
-    
+    timer.stage("复制文件", || copy_files_to_build(project_path, rmake_config))?;
+
     // 2. 复制 update.json 到 dist 目录
-    copy_update_json_to_dist(project_path)?;
-    
+    timer.stage("复制 update.json", || copy_update_json_to_dist(project_path))?;
+
     // 3. 执行 shell 脚本检查
-    check_shell_scripts(project_path, auto_fix)?;
-    
+    timer.stage("shellcheck", || check_shell_scripts(project_path, rmake_config, auto_fix))?;
+
     // 4. 执行 prebuild 配置
-    execute_prebuild(project_path, rmake_config)?;
-    
+    timer.stage("prebuild", || execute_prebuild(project_path, rmake_config))?;
+
     // 5. 打包模块
-    package_module(project_path, rmake_config)?;
-    
+    timer.stage("打包模块", || package_module(project_path, rmake_config))?;
+
     // 6. 执行 postbuild
-    execute_postbuild(project_path, rmake_config)?;
-    
+    timer.stage("postbuild", || execute_postbuild(project_path, rmake_config))?;
+
+    Ok(())
+}
+
+/// 快速复制单个文件：只读输入先试硬链接（纯元数据操作），
+/// 其余走 fs::copy —— Linux 上内部使用 copy_file_range，
+/// 在 btrfs/XFS 等支持 reflink 的文件系统上同样是元数据级克隆
+fn fast_copy_file(src: &Path, dst: &Path) -> Result<()> {
+    if dst.exists() {
+        fs::remove_file(dst)?;
+    }
+
+    if let Ok(meta) = fs::metadata(src) {
+        if meta.permissions().readonly() {
+            // 只读的静态载荷不会被后续阶段修改，硬链接零拷贝；
+            // 跨设备等失败时静默回退真实复制
+            if fs::hard_link(src, dst).is_ok() {
+                return Ok(());
+            }
+        }
+    }
+
+    fs::copy(src, dst)?;
     Ok(())
 }
 
-/// 复制文件到构建目录
+/// 复制文件到构建目录（并行复制引擎）
+///
+/// 先展开全部目标文件并建好目录骨架，再把复制任务分发到 rayon 线程池：
+/// 需要行尾规范化的文本走原有的读写路径，其余文件走 fast_copy_file
 fn copy_files_to_build(
     project_path: &Path,
     rmake_config: &RmakeConfig,
 ) -> Result<()> {
+    use rayon::prelude::*;
+
     let build_dir = project_path.join(".rmmp/build");
-    
-    // 获取需要复制的文件和目录
+
+    // 获取需要复制的文件和目录，展开为 (源文件, 目标文件) 任务列表
     let entries = get_build_entries(project_path, rmake_config)?;
-    
+    let mut copy_jobs: Vec<(PathBuf, PathBuf)> = Vec::new();
+
     for entry in entries {
-        let relative_path = entry.strip_prefix(project_path)?;
-        let dest_path = build_dir.join(relative_path);
-          if entry.is_dir() {
-            fs::create_dir_all(&dest_path)?;
-            copy_directory(&entry, &dest_path)?;
+        if entry.is_dir() {
+            for file in walkdir::WalkDir::new(&entry).into_iter().filter_map(|e| e.ok()) {
+                let relative_path = file.path().strip_prefix(project_path)?;
+                let dest_path = build_dir.join(relative_path);
+                if file.file_type().is_dir() {
+                    fs::create_dir_all(&dest_path)?;
+                } else if file.file_type().is_file() {
+                    copy_jobs.push((file.path().to_path_buf(), dest_path));
+                }
+            }
         } else {
+            let relative_path = entry.strip_prefix(project_path)?;
+            let dest_path = build_dir.join(relative_path);
             if let Some(parent) = dest_path.parent() {
                 fs::create_dir_all(parent)?;
             }
-            copy_file_with_line_ending_normalization(&entry, &dest_path)?;
+            copy_jobs.push((entry, dest_path));
         }
     }
-    
-    println!("{} 复制文件到构建目录", "[+]".green().bold());
+
+    // 并行分发：文本规范化与快速复制都在工作线程内完成
+    copy_jobs
+        .par_iter()
+        .map(|(src, dst)| -> Result<()> {
+            if needs_line_ending_normalization(src) {
+                copy_file_with_line_ending_normalization(src, dst)
+            } else {
+                fast_copy_file(src, dst)
+            }
+        })
+        .collect::<Result<Vec<_>>>()?;
+
+    println!("{} 复制文件到构建目录（{} 个文件，{} 线程）", "[+]".green().bold(), copy_jobs.len(), rayon::current_num_threads());
     Ok(())
 }
 
@@ -175,6 +790,22 @@ fn copy_files_to_build(
 fn get_build_entries(
     project_path: &Path,
     rmake_config: &RmakeConfig,
+) -> Result<Vec<PathBuf>> {
+    get_build_entries_impl(project_path, rmake_config, true)
+}
+
+/// 获取构建条目（静默版本，供清单计算等内部流程使用）
+fn get_build_entries_quiet(
+    project_path: &Path,
+    rmake_config: &RmakeConfig,
+) -> Result<Vec<PathBuf>> {
+    get_build_entries_impl(project_path, rmake_config, false)
+}
+
+fn get_build_entries_impl(
+    project_path: &Path,
+    rmake_config: &RmakeConfig,
+    verbose: bool,
 ) -> Result<Vec<PathBuf>> {
     let mut entries = Vec::new();
     
@@ -194,7 +825,7 @@ fn get_build_entries(
     }
       // 应用 exclude 规则（排除文件）
     let exclude_patterns = &rmake_config.build.exclude;
-    if !exclude_patterns.is_empty() {
+    if verbose && !exclude_patterns.is_empty() {
         println!("    {} 应用排除规则:", "[!]".bright_yellow());
         for pattern in exclude_patterns {
             println!("      - {}", pattern);
@@ -212,21 +843,27 @@ fn get_build_entries(
                 if pattern.ends_with("*") {
                     let prefix = &pattern[..pattern.len() - 1];
                     if file_name.starts_with(prefix) || path_str.contains(prefix) {
-                        println!("      {} 排除文件: {} (匹配 {})", "[x]".red(), file_name, pattern);
+                        if verbose {
+                            println!("      {} 排除文件: {} (匹配 {})", "[x]".red(), file_name, pattern);
+                        }
                         return false;
                     }
                 }
                 if pattern.starts_with("*") {
                     let suffix = &pattern[1..];
                     if file_name.ends_with(suffix) || path_str.contains(suffix) {
-                        println!("      {} 排除文件: {} (匹配 {})", "[x]".red(), file_name, pattern);
+                        if verbose {
+                            println!("      {} 排除文件: {} (匹配 {})", "[x]".red(), file_name, pattern);
+                        }
                         return false;
                     }
                 }
             } else {
                 // 精确匹配
                 if file_name == pattern.as_str() || path_str.contains(pattern) {
-                    println!("      {} 排除文件: {} (匹配 {})", "[x]".red(), file_name, pattern);
+                    if verbose {
+                        println!("      {} 排除文件: {} (匹配 {})", "[x]".red(), file_name, pattern);
+                    }
                     return false;
                 }
             }
@@ -244,7 +881,7 @@ fn get_build_entries(
         })
         .collect();
     
-    if !include_patterns.is_empty() {
+    if verbose && !include_patterns.is_empty() {
         println!("    {} 额外包含规则:", "[+]".green());
         for pattern in &include_patterns {
             println!("      + {}", pattern);
@@ -308,25 +945,48 @@ fn copy_update_json_to_dist(project_path: &Path) -> Result<()> {
 }
 
 /// 检查 shell 脚本
-fn check_shell_scripts(project_path: &Path, auto_fix: bool) -> Result<()> {
+fn check_shell_scripts(project_path: &Path, rmake_config: &RmakeConfig, auto_fix: bool) -> Result<()> {
     let build_dir = project_path.join(".rmmp/build");
+
+    // 查找所有 .sh 文件（沿用 BuildConfig.exclude 规则）
+    let sh_files = find_shell_scripts(&build_dir, &rmake_config.build.exclude)?;
+    check_shell_scripts_files(project_path, sh_files, auto_fix)
+}
+
+/// 流式模式：直接检查源目录中的 shell 脚本（不经过暂存树）
+fn check_shell_scripts_streaming(
+    project_path: &Path,
+    rmake_config: &RmakeConfig,
+    auto_fix: bool,
+) -> Result<()> {
+    let (_, files) = collect_streaming_entries(project_path, rmake_config)?;
+    let sh_files: Vec<PathBuf> = files
+        .into_iter()
+        .map(|(path, _)| path)
+        .filter(|path| path.extension().map_or(false, |ext| ext == "sh"))
+        .collect();
+    check_shell_scripts_files(project_path, sh_files, auto_fix)
+}
+
+/// 对给定脚本列表执行 shellcheck 检查
+fn check_shell_scripts_files(project_path: &Path, sh_files: Vec<PathBuf>, auto_fix: bool) -> Result<()> {
     let rmmp_dir = project_path.join(".rmmp");
-    
-    // 查找所有 .sh 文件
-    let sh_files = find_shell_scripts(&build_dir)?;
-    
+
     if sh_files.is_empty() {
         return Ok(());
     }
     
     println!("{} 检查 shell 脚本", "[+]".green().bold());
-    
-    // 检查是否安装了 shellcheck
-    let shellcheck_available = Command::new("shellcheck")
-        .arg("--version")
-        .output()
-        .is_ok();
-    
+
+    // 检查是否安装了 shellcheck（进程级缓存，批量构建时多个项目共享探测结果）
+    static SHELLCHECK_AVAILABLE: std::sync::OnceLock<bool> = std::sync::OnceLock::new();
+    let shellcheck_available = *SHELLCHECK_AVAILABLE.get_or_init(|| {
+        Command::new("shellcheck")
+            .arg("--version")
+            .output()
+            .is_ok()
+    });
+
     if !shellcheck_available {
         println!("{} shellcheck 未安装，跳过脚本检查", "[!]".yellow().bold());
         return Ok(());
@@ -344,73 +1004,119 @@ fn check_shell_scripts(project_path: &Path, auto_fix: bool) -> Result<()> {
     
     let mut has_errors = false;
     let mut all_fixes = String::new(); // 收集所有修复建
-    
-    // 对每个 shell 脚本运行 shellcheck
+
+    // 结果缓存：按文件内容哈希命中，未变化的脚本完全跳过 shellcheck
+    let cache_path = rmmp_dir.join("shellcheck-cache.json");
+    let mut result_cache: HashMap<String, ShellcheckCacheEntry> = fs::read_to_string(&cache_path)
+        .ok()
+        .and_then(|content| serde_json::from_str(&content).ok())
+        .unwrap_or_default();
+
+    // 计算内容哈希，区分缓存命中与需要重新检查的文件
+    let mut content_hashes = HashMap::new();
+    let mut changed_files = Vec::new();
     for sh_file in &sh_files {
-        println!("    检查: {}", sh_file.display());
-        report.checked_files.push(sh_file.to_string_lossy().to_string());
-        
-        // 使用 JSON 格式输出获取详细信息
-        let json_output = Command::new("shellcheck")
-            .arg("--format=json")
-            .arg(&sh_file)
-            .output()?;
-        
-        // 获取带 wiki 链接的详细输出
-        let wiki_output = Command::new("shellcheck")
-            .arg("-W")
-            .arg("10") // 显示最多10个wiki链接
-            .arg(&sh_file)
-            .output()?;
-        
-        // 获取 diff 格式的修复建议
-        let diff_output = Command::new("shellcheck")
-            .arg("--format=diff")
-            .arg(&sh_file)
-            .output()?;
-        
-        // 解析 JSON 输出
-        if !json_output.stdout.is_empty() {
-            let json_str = String::from_utf8_lossy(&json_output.stdout);
-            if let Ok(issues) = serde_json::from_str::<Vec<ShellcheckIssue>>(&json_str) {
-                for issue in issues {
-                    // 统计各类问题数量
-                    match issue.level.as_str() {
-                        "error" => {
-                            report.error_count += 1;
-                            has_errors = true;
-                        }
-                        "warning" => report.warning_count += 1,
-                        "info" => report.info_count += 1,
-                        "style" => report.style_count += 1,
-                        _ => {}
-                    }
-                    report.issues.push(issue);
+        let key = sh_file.to_string_lossy().to_string();
+        report.checked_files.push(key.clone());
+
+        let content = fs::read(sh_file)?;
+        let mut crc = flate2::Crc::new();
+        crc.update(&content);
+        let hash = crc.sum();
+
+        match result_cache.get(&key) {
+            Some(entry) if entry.content_hash == hash => {
+                println!("    检查: {} (缓存命中)", sh_file.display());
+            }
+            _ => changed_files.push(sh_file.clone()),
+        }
+        content_hashes.insert(key, hash);
+    }
+
+    // 按核心数切分批次，每个批次一次 shellcheck 调用、批次间并行
+    if !changed_files.is_empty() {
+        use rayon::prelude::*;
+
+        let batch_count = rayon::current_num_threads().min(changed_files.len());
+        let batch_size = changed_files.len().div_ceil(batch_count);
+        let batch_results: Vec<Result<(Vec<PathBuf>, ShellcheckBatchOutput)>> = changed_files
+            .par_chunks(batch_size)
+            .map(|batch| {
+                for sh_file in batch {
+                    println!("    检查: {}", sh_file.display());
                 }
+                run_shellcheck_batch(batch).map(|output| (batch.to_vec(), output))
+            })
+            .collect();
+
+        for batch_result in batch_results {
+            let (batch, output) = batch_result?;
+
+            // 按文件归并批次结果，写入缓存
+            let mut per_file_issues: HashMap<String, Vec<ShellcheckIssue>> = HashMap::new();
+            for issue in output.issues {
+                per_file_issues.entry(issue.file.clone()).or_default().push(issue);
+            }
+            let mut per_file_diffs = split_diff_by_file(&output.fixes_diff);
+
+            for sh_file in batch {
+                let key = sh_file.to_string_lossy().to_string();
+                let entry = ShellcheckCacheEntry {
+                    content_hash: content_hashes[&key],
+                    issues: per_file_issues.remove(&key).unwrap_or_default(),
+                    fixes_diff: per_file_diffs.remove(&key).unwrap_or_default(),
+                };
+                if entry.issues.is_empty() {
+                    println!("{} shellcheck 检查通过: {}", "✅".green(), sh_file.display());
+                }
+                result_cache.insert(key, entry);
+            }
+
+            // 显示带 wiki 链接的详细输出
+            if !output.wiki_text.trim().is_empty() {
+                println!("{} shellcheck 发现问题:", "[!]".yellow().bold());
+                println!("{}", output.wiki_text);
             }
         }
-        
-        // 处理修复建议
-        if !diff_output.stdout.is_empty() {
-            let diff_content = String::from_utf8_lossy(&diff_output.stdout);
-            if !diff_content.trim().is_empty() {
+    }
+
+    // 从缓存（命中 + 新鲜结果）汇总报告
+    for sh_file in &sh_files {
+        let key = sh_file.to_string_lossy().to_string();
+        if let Some(entry) = result_cache.get(&key) {
+            for issue in &entry.issues {
+                // 统计各类问题数量
+                match issue.level.as_str() {
+                    "error" => {
+                        report.error_count += 1;
+                        has_errors = true;
+                    }
+                    "warning" => report.warning_count += 1,
+                    "info" => report.info_count += 1,
+                    "style" => report.style_count += 1,
+                    _ => {}
+                }
+            }
+            report.issues.extend(entry.issues.iter().cloned());
+
+            if !entry.fixes_diff.trim().is_empty() {
                 all_fixes.push_str(&format!("\n=== {} ===\n", sh_file.display()));
-                all_fixes.push_str(&diff_content);
+                all_fixes.push_str(&entry.fixes_diff);
                 all_fixes.push_str("\n");
             }
         }
-        
-        // 如果有问题，显示详细信息
-        if !wiki_output.status.success() || !wiki_output.stdout.is_empty() {
-            let output_str = String::from_utf8_lossy(&wiki_output.stdout);
-            if !output_str.trim().is_empty() {
-                println!("{} shellcheck 发现问题: {}", "[!]".yellow().bold(), sh_file.display());
-                println!("{}", output_str);
-            }
-        } else {
-            println!("{} shellcheck 检查通过: {}", "✅".green(), sh_file.display());
-        }
-    }    
+    }
+
+    // 清理已删除脚本的缓存项并落盘
+    let live_keys: std::collections::HashSet<String> = sh_files
+        .iter()
+        .map(|f| f.to_string_lossy().to_string())
+        .collect();
+    result_cache.retain(|key, _| live_keys.contains(key));
+    if let Ok(content) = serde_json::to_string(&result_cache) {
+        let _ = fs::write(&cache_path, content);
+    }
+
     report.total_issues = report.error_count + report.warning_count + report.info_count + report.style_count;
     
     // 写入 JSON 格式报告（机器友好）
@@ -485,33 +1191,45 @@ fn check_shell_scripts(project_path: &Path, auto_fix: bool) -> Result<()> {
     Ok(())
 }
 
-/// 查找所有 shell 脚本文件
-fn find_shell_scripts(dir: &Path) -> Result<Vec<PathBuf>> {
-    let mut sh_files = Vec::new();
-    
+/// 查找所有 shell 脚本文件（并行 + 尊重 gitignore + BuildConfig.exclude 规则）
+///
+/// 隐藏目录（.git、.rmmp 等）默认跳过，.gitignore 覆盖的生成物不再进入
+/// shellcheck，大目录树上并行遍历比朴素递归快一个量级
+fn find_shell_scripts(dir: &Path, exclude: &[String]) -> Result<Vec<PathBuf>> {
     if !dir.exists() {
-        return Ok(sh_files);
+        return Ok(Vec::new());
     }
-    
-    find_shell_scripts_recursive(dir, &mut sh_files)?;
-    Ok(sh_files)
-}
 
-/// 递归查找 shell 脚本
-fn find_shell_scripts_recursive(dir: &Path, sh_files: &mut Vec<PathBuf>) -> Result<()> {
-    for entry in fs::read_dir(dir)? {
-        let entry = entry?;
-        let path = entry.path();
-        
-        if path.is_dir() {
-            find_shell_scripts_recursive(&path, sh_files)?;
-        } else if let Some(extension) = path.extension() {
-            if extension == "sh" {
-                sh_files.push(path);
-            }
+    // BuildConfig.exclude 模式以 "!" 前缀注册为排除覆盖
+    let mut overrides = ignore::overrides::OverrideBuilder::new(dir);
+    for pattern in exclude {
+        if overrides.add(&format!("!{}", pattern)).is_err() {
+            println!("⚠️ 警告: 无效的排除模式，忽略: {}", pattern);
         }
     }
-    Ok(())
+    let overrides = overrides.build()?;
+
+    let found = std::sync::Mutex::new(Vec::new());
+    ignore::WalkBuilder::new(dir)
+        .overrides(overrides)
+        .follow_links(false)
+        .build_parallel()
+        .run(|| {
+            Box::new(|entry| {
+                if let Ok(entry) = entry {
+                    if entry.file_type().map_or(false, |t| t.is_file())
+                        && entry.path().extension().map_or(false, |ext| ext == "sh")
+                    {
+                        found.lock().unwrap().push(entry.path().to_path_buf());
+                    }
+                }
+                ignore::WalkState::Continue
+            })
+        });
+
+    let mut sh_files = found.into_inner().unwrap();
+    sh_files.sort();
+    Ok(sh_files)
 }
 
 /// 执行 prebuild 脚本
@@ -578,23 +1296,133 @@ fn execute_prebuild(
 /// 打包模块
 fn package_module(
     project_path: &Path,
-    _rmake_config: &RmakeConfig,
+    rmake_config: &RmakeConfig,
 ) -> Result<()> {
     let build_dir = project_path.join(".rmmp/build");
     let dist_dir = project_path.join(".rmmp/dist");
-    
+
     // 读取项目信息
     let project_info = read_project_info(project_path)?;
     let module_name = format!("{}-{}.zip", project_info.id, project_info.version_code);
     let output_path = dist_dir.join(&module_name);
-    
-    println!("{} 打包模块: {}", "[zip]".magenta().bold(), module_name.cyan());
-    
-    // 创建 ZIP 文件
-    create_zip_archive(&build_dir, &output_path)?;
-    
+
+    let profile = rmake_config.build.compression.as_deref().unwrap_or("balanced");
+    println!("{} 打包模块: {} (压缩配置: {})", "[zip]".magenta().bold(), module_name.cyan(), profile);
+
+    // 创建 ZIP 文件（多线程压缩）
+    create_zip_archive_with_profile(&build_dir, &output_path, profile)?;
+
     println!("{} 模块打包完成: {}", "✅".green().bold(), output_path.display());
-    
+
+    // 增量更新包：与上一个版本的 zip 做差量（失败不阻塞构建）
+    if let Err(e) = create_delta_package(project_path, &output_path, &project_info) {
+        println!("⚠️ 警告: 生成增量更新包失败: {}", e);
+    }
+
+    Ok(())
+}
+
+/// 在 dist 目录中查找上一个版本的完整 zip（versionCode 最高且低于当前版本）
+fn find_previous_release_zip(dist_dir: &Path, project_info: &ProjectInfo) -> Option<(PathBuf, u64)> {
+    let current_code: u64 = project_info.version_code.parse().ok()?;
+    let prefix = format!("{}-", project_info.id);
+    let mut best: Option<(PathBuf, u64)> = None;
+
+    for entry in fs::read_dir(dist_dir).ok()?.filter_map(|e| e.ok()) {
+        let name = entry.file_name().to_string_lossy().to_string();
+        if !name.starts_with(&prefix) || !name.ends_with(".zip") || name.ends_with(".delta.zip") {
+            continue;
+        }
+        let code_str = &name[prefix.len()..name.len() - 4];
+        if let Ok(code) = code_str.parse::<u64>() {
+            if code < current_code && best.as_ref().map_or(true, |(_, c)| code > *c) {
+                best = Some((entry.path(), code));
+            }
+        }
+    }
+
+    best
+}
+
+/// 生成增量更新包：只收录相对上一版 zip 新增或变化的条目
+///
+/// 逐条目比较两个 zip 中央目录里的 CRC32（无需解压），变化的条目以
+/// raw_copy 直接搬运压缩数据；包内附带 rmm-delta.json 记录基准/目标
+/// versionCode 和被删除的文件清单，客户端据此在本地旧包上应用差量。
+/// 同时把差量包文件名写入 update.json（deltaZip / deltaFrom 字段）。
+fn create_delta_package(project_path: &Path, new_zip_path: &Path, project_info: &ProjectInfo) -> Result<()> {
+    let dist_dir = project_path.join(".rmmp/dist");
+    let Some((previous_zip, previous_code)) = find_previous_release_zip(&dist_dir, project_info) else {
+        return Ok(()); // 没有上一版可以做差量
+    };
+
+    // 读取两个 zip 的条目 CRC 表（只读中央目录）
+    let mut old_archive = zip::ZipArchive::new(fs::File::open(&previous_zip)?)?;
+    let mut old_crcs: HashMap<String, u32> = HashMap::new();
+    for i in 0..old_archive.len() {
+        let entry = old_archive.by_index_raw(i)?;
+        old_crcs.insert(entry.name().to_string(), entry.crc32());
+    }
+
+    let mut new_archive = zip::ZipArchive::new(fs::File::open(new_zip_path)?)?;
+
+    let delta_name = format!(
+        "{}-{}-to-{}.delta.zip",
+        project_info.id, previous_code, project_info.version_code
+    );
+    let delta_path = dist_dir.join(&delta_name);
+    let mut writer = zip::ZipWriter::new(fs::File::create(&delta_path)?);
+
+    let mut changed = 0usize;
+    let mut new_names = std::collections::HashSet::new();
+    for i in 0..new_archive.len() {
+        let entry = new_archive.by_index_raw(i)?;
+        let name = entry.name().to_string();
+        new_names.insert(name.clone());
+        if old_crcs.get(&name) == Some(&entry.crc32()) {
+            continue; // 未变化
+        }
+        writer.raw_copy_file(entry)?;
+        changed += 1;
+    }
+
+    // 被删除的文件记录在包内清单里
+    let removed: Vec<&String> = old_crcs.keys().filter(|name| !new_names.contains(*name)).collect();
+    let delta_manifest = serde_json::json!({
+        "baseVersionCode": previous_code,
+        "targetVersionCode": project_info.version_code,
+        "removed": removed,
+    });
+    writer.start_file("rmm-delta.json", zip::write::SimpleFileOptions::default())?;
+    writer.write_all(serde_json::to_string_pretty(&delta_manifest)?.as_bytes())?;
+    writer.finish()?;
+
+    println!(
+        "{} 增量更新包: {} ({} 个变化条目, 基于 versionCode {})",
+        "[Δ]".magenta().bold(), delta_name.cyan(), changed, previous_code
+    );
+
+    // 在 update.json 中记录差量信息，供客户端选择小包下载。
+    // dist 副本在打包阶段之前就已复制，这里必须一并更新，
+    // 否则发布上传的 .rmmp/dist/update.json 不会指向本次构建的差量包
+    for update_json_path in [project_path.join("update.json"), dist_dir.join("update.json")] {
+        if !update_json_path.exists() {
+            continue;
+        }
+        let content = fs::read_to_string(&update_json_path)?;
+        if let Ok(mut json_value) = serde_json::from_str::<serde_json::Value>(&content) {
+            if let Some(obj) = json_value.as_object_mut() {
+                obj.insert("deltaZip".to_string(), serde_json::Value::String(delta_name.clone()));
+                obj.insert(
+                    "deltaFrom".to_string(),
+                    serde_json::Value::Number(serde_json::Number::from(previous_code)),
+                );
+                fs::write(&update_json_path, serde_json::to_string_pretty(&json_value)?)?;
+                println!("    📄 已记录差量信息到 {}", update_json_path.display());
+            }
+        }
+    }
+
     Ok(())
 }
 
@@ -625,61 +1453,213 @@ struct ProjectInfo {
     version_code: String,
 }
 
-/// 创建 ZIP 压缩包
-fn create_zip_archive(source_dir: &Path, output_path: &Path) -> Result<()> {
+/// 根据压缩配置生成 zip 条目选项
+fn zip_options_for_profile(profile: &str) -> zip::write::SimpleFileOptions {
+    use zip::CompressionMethod;
+    let options = zip::write::SimpleFileOptions::default();
+    match profile {
+        // 已压缩的负载（.so、busybox 等二进制）直接存储，不再浪费 CPU
+        "store" => options.compression_method(CompressionMethod::Stored),
+        "fast" => options
+            .compression_method(CompressionMethod::Deflated)
+            .compression_level(Some(1)),
+        "max" => options
+            .compression_method(CompressionMethod::Deflated)
+            .compression_level(Some(9)),
+        // balanced 或未知值都使用默认压缩级别
+        _ => options.compression_method(CompressionMethod::Deflated),
+    }
+}
+
+/// 创建 ZIP 压缩包（多线程压缩）
+///
+/// 每个文件在独立的 rayon 任务中压缩为单条目的内存 zip，
+/// 最后按固定顺序把原始压缩数据拼接进输出文件并统一写中央目录，
+/// 大体积的 .so / busybox 等文件不会再把打包压在单核上。
+fn create_zip_archive_with_profile(source_dir: &Path, output_path: &Path, profile: &str) -> Result<()> {
+    // 收集所有目录和文件条目（目录条目不需要压缩）
+    let mut dir_names = Vec::new();
+    let mut files = Vec::new();
+    for entry in walkdir::WalkDir::new(source_dir)
+        .min_depth(1)
+        .sort_by_file_name()
+        .into_iter()
+        .filter_map(|e| e.ok())
+    {
+        let relative_path = entry.path().strip_prefix(source_dir)?;
+        // 确保使用正斜杠分隔符
+        let name = relative_path.display().to_string().replace('\\', "/");
+        if entry.file_type().is_dir() {
+            dir_names.push(format!("{}/", name));
+        } else {
+            files.push((entry.path().to_path_buf(), name));
+        }
+    }
+
+    // 暂存树已经做过行尾规范化，直接压缩
+    write_zip_parallel(dir_names, files, output_path, zip_options_for_profile(profile), false)
+}
+
+/// 并行压缩给定条目并写出 zip
+///
+/// normalize 为 true 时对文本文件在内存中做 CRLF→LF 规范化，
+/// 供流式打包使用（源文件不经过暂存树的复制规范化）。
+fn write_zip_parallel(
+    dir_names: Vec<String>,
+    files: Vec<(PathBuf, String)>,
+    output_path: &Path,
+    options: zip::write::SimpleFileOptions,
+    normalize: bool,
+) -> Result<()> {
+    use rayon::prelude::*;
+    use std::io::Cursor;
+
+    // 并行压缩：每个文件得到一个单条目的内存 zip
+    let compressed: Vec<Result<Vec<u8>>> = files
+        .par_iter()
+        .map(|(path, name)| {
+            let content = if normalize && needs_line_ending_normalization(path) {
+                normalize_line_endings(&fs::read_to_string(path)?).into_bytes()
+            } else {
+                fs::read(path)?
+            };
+            let mut cursor = Cursor::new(Vec::new());
+            let mut writer = zip::ZipWriter::new(&mut cursor);
+            writer.start_file(name.clone(), options)?;
+            writer.write_all(&content)?;
+            writer.finish()?;
+            Ok(cursor.into_inner())
+        })
+        .collect();
+
+    // 拼接：raw_copy_file 直接搬运已压缩的数据，单线程只负责写出和中央目录
     let file = fs::File::create(output_path)?;
     let mut zip = zip::ZipWriter::new(file);
-    
-    add_directory_to_zip(&mut zip, source_dir, source_dir)?;
-    
+
+    for dir_name in dir_names {
+        zip.add_directory(dir_name, options)?;
+    }
+
+    for buffer in compressed {
+        let mut archive = zip::ZipArchive::new(Cursor::new(buffer?))?;
+        let entry = archive.by_index_raw(0)?;
+        zip.raw_copy_file(entry)?;
+    }
+
     zip.finish()?;
     Ok(())
 }
 
-/// 添加目录到 ZIP
-fn add_directory_to_zip<W: Write + std::io::Seek>(
-    zip: &mut zip::ZipWriter<W>,
-    dir: &Path,
-    base_dir: &Path,
-) -> Result<()> {
-    for entry in fs::read_dir(dir)? {
-        let entry = entry?;
-        let path = entry.path();
-        let relative_path = path.strip_prefix(base_dir)?;
-          if path.is_dir() {
-            // 添加目录 - 确保使用正斜杠分隔符
-            let dir_name = format!("{}/", relative_path.display().to_string().replace('\\', "/"));
-            zip.add_directory(dir_name, zip::write::SimpleFileOptions::default())?;
-            
-            // 递归添加子目录
-            add_directory_to_zip(zip, &path, base_dir)?;
+/// 收集流式打包的 zip 条目：目录名列表 + (源路径, zip 内名称) 文件列表
+fn collect_streaming_entries(
+    project_path: &Path,
+    rmake_config: &RmakeConfig,
+) -> Result<(Vec<String>, Vec<(PathBuf, String)>)> {
+    let mut dir_names = Vec::new();
+    let mut files = Vec::new();
+
+    for entry in get_build_entries_quiet(project_path, rmake_config)? {
+        if entry.is_dir() {
+            for item in walkdir::WalkDir::new(&entry)
+                .sort_by_file_name()
+                .into_iter()
+                .filter_map(|e| e.ok())
+            {
+                let relative = item.path().strip_prefix(project_path)?;
+                let name = relative.display().to_string().replace('\\', "/");
+                if item.file_type().is_dir() {
+                    dir_names.push(format!("{}/", name));
+                } else {
+                    files.push((item.path().to_path_buf(), name));
+                }
+            }
         } else {
-            // 添加文件 - 确保使用正斜杠分隔符
-            let file_name = relative_path.display().to_string().replace('\\', "/");
-            zip.start_file(file_name, zip::write::SimpleFileOptions::default())?;
-            
-            let file_content = fs::read(&path)?;
-            zip.write_all(&file_content)?;
+            let relative = entry.strip_prefix(project_path)?;
+            let name = relative.display().to_string().replace('\\', "/");
+            files.push((entry.clone(), name));
         }
     }
-    
+
+    Ok((dir_names, files))
+}
+
+/// 流式打包模块：源文件只读取一次，zip 条目直接写入分发目录
+fn package_module_streaming(project_path: &Path, rmake_config: &RmakeConfig) -> Result<()> {
+    let dist_dir = project_path.join(".rmmp/dist");
+
+    // 读取项目信息
+    let project_info = read_project_info(project_path)?;
+    let module_name = format!("{}-{}.zip", project_info.id, project_info.version_code);
+    let output_path = dist_dir.join(&module_name);
+
+    let profile = rmake_config.build.compression.as_deref().unwrap_or("balanced");
+    println!("{} 流式打包模块: {} (压缩配置: {})", "[zip]".magenta().bold(), module_name.cyan(), profile);
+
+    let (dir_names, files) = collect_streaming_entries(project_path, rmake_config)?;
+    write_zip_parallel(dir_names, files, &output_path, zip_options_for_profile(profile), true)?;
+
+    println!("{} 模块打包完成: {}", "✅".green().bold(), output_path.display());
+
+    // 增量更新包：与上一个版本的 zip 做差量（失败不阻塞构建）
+    if let Err(e) = create_delta_package(project_path, &output_path, &project_info) {
+        println!("⚠️ 警告: 生成增量更新包失败: {}", e);
+    }
+
     Ok(())
 }
 
-/// 创建 tar.gz 压缩包
-fn create_tar_gz_archive(source_dir: &Path, output_path: &Path) -> Result<()> {
+/// 先把目录打成未压缩的 tar 字节流（压缩阶段随后并行处理）
+fn build_source_tar(source_dir: &Path) -> Result<Vec<u8>> {
+    let mut tar = tar::Builder::new(Vec::new());
+    add_directory_to_tar(&mut tar, source_dir, source_dir)?;
+    Ok(tar.into_inner()?)
+}
+
+/// 压缩配置 → (gzip 级别, zstd 级别)
+fn source_levels_for_profile(profile: &str) -> (u32, i32) {
+    match profile {
+        "store" | "fast" => (1, 1),
+        "max" => (9, 19),
+        _ => (6, 3), // balanced / 默认
+    }
+}
+
+/// pigz 风格的块并行 gzip：tar 流按 1MB 分块，各块独立压缩成
+/// gzip member 后按序拼接——多 member 拼接仍是合法的 gzip 流
+fn create_tar_gz_archive_parallel(source_dir: &Path, output_path: &Path, level: u32) -> Result<()> {
     use flate2::Compression;
     use flate2::write::GzEncoder;
-    use tar::Builder;
-    
-    let tar_gz_file = fs::File::create(output_path)?;
-    let enc = GzEncoder::new(tar_gz_file, Compression::default());
-    let mut tar = Builder::new(enc);
-    
-    // 递归添加目录中的所有文件
-    add_directory_to_tar(&mut tar, source_dir, source_dir)?;
-    
-    tar.finish()?;
+    use rayon::prelude::*;
+
+    let tar_bytes = build_source_tar(source_dir)?;
+
+    const BLOCK_SIZE: usize = 1 << 20;
+    let blocks: Vec<Vec<u8>> = tar_bytes
+        .par_chunks(BLOCK_SIZE)
+        .map(|chunk| -> Result<Vec<u8>> {
+            let mut encoder = GzEncoder::new(Vec::new(), Compression::new(level));
+            encoder.write_all(chunk)?;
+            Ok(encoder.finish()?)
+        })
+        .collect::<Result<Vec<_>>>()?;
+
+    let mut output = std::io::BufWriter::new(fs::File::create(output_path)?);
+    for block in blocks {
+        output.write_all(&block)?;
+    }
+    output.flush()?;
+    Ok(())
+}
+
+/// 多线程 zstd 压缩（zstdmt，工作线程数取 rayon 线程池大小）
+fn create_tar_zst_archive(source_dir: &Path, output_path: &Path, level: i32) -> Result<()> {
+    let tar_bytes = build_source_tar(source_dir)?;
+
+    let output = fs::File::create(output_path)?;
+    let mut encoder = zstd::Encoder::new(output, level)?;
+    encoder.multithread(rayon::current_num_threads() as u32)?;
+    encoder.write_all(&tar_bytes)?;
+    encoder.finish()?;
     Ok(())
 }
 
@@ -863,7 +1843,7 @@ fn execute_source_packaging(
     execute_source_prebuild(project_path)?;
     
     // 打包源代码
-    package_source_code(project_path, &source_build_dir)?;
+    package_source_code(project_path, &source_build_dir, rmake_config)?;
     
     // 执行源代码 postbuild
     execute_source_postbuild(project_path)?;
@@ -1033,7 +2013,7 @@ fn execute_source_prebuild(project_path: &Path) -> Result<()> {
 }
 
 /// 打包源代码
-fn package_source_code(project_path: &Path, source_build_dir: &Path) -> Result<()> {
+fn package_source_code(project_path: &Path, source_build_dir: &Path, rmake_config: &RmakeConfig) -> Result<()> {
     // 🔧 修复：验证源目录
     if !source_build_dir.exists() {
         return Err(anyhow::anyhow!("源代码构建目录不存在: {}", source_build_dir.display()));
@@ -1054,13 +2034,24 @@ fn package_source_code(project_path: &Path, source_build_dir: &Path) -> Result<(
     }
     
     let project_info = read_project_info(project_path)?;
-    let source_name = format!("{}-{}-source.tar.gz", project_info.id, project_info.version_code);
+
+    // 输出格式与压缩级别由 Rmake.toml 的 build 配置决定
+    let format = rmake_config.build.source_format.as_deref().unwrap_or("tar.gz");
+    let profile = rmake_config.build.compression.as_deref().unwrap_or("balanced");
+    let (gzip_level, zstd_level) = source_levels_for_profile(profile);
+
+    let source_name = format!("{}-{}-source.{}", project_info.id, project_info.version_code, format);
     let output_path = dist_dir.join(&source_name);
-    
-    println!("{} 打包源代码: {}", "[tar]".cyan().bold(), source_name.cyan());
-    
+
+    println!("{} 打包源代码: {} ({} 线程)", "[tar]".cyan().bold(), source_name.cyan(), rayon::current_num_threads());
+
+    let archive_result = match format {
+        "tar.zst" => create_tar_zst_archive(source_build_dir, &output_path, zstd_level),
+        _ => create_tar_gz_archive_parallel(source_build_dir, &output_path, gzip_level),
+    };
+
     // 🔧 修复：添加详细的错误处理
-    match create_tar_gz_archive(source_build_dir, &output_path) {
+    match archive_result {
         Ok(()) => {
             println!("{} 源代码打包完成: {}", "✅".green().bold(), output_path.display());
             Ok(())
@@ -0,0 +1,292 @@
+use anyhow::{Context, Result};
+use colored::Colorize;
+use std::fs;
+use std::io::{self, BufReader, Read};
+use std::path::{Path, PathBuf};
+
+/// 模块 zip 必须包含的条目（Magisk/KernelSU 安装器约定）
+const REQUIRED_ENTRIES: &[&str] = &[
+    "module.prop",
+    "META-INF/com/google/android/update-binary",
+    "META-INF/com/google/android/updater-script",
+];
+
+/// module.prop 必须包含的键
+const REQUIRED_PROP_KEYS: &[&str] = &["id", "name", "version", "versionCode"];
+
+/// 校验构建产物：流式走中央目录逐条目验证 CRC 与模块布局，全程不落盘解压
+///
+/// artifact 为 None 时自动定位 .rmmp/dist 下最新的 zip
+pub fn check_artifact(project_path: &Path, artifact: Option<&str>) -> Result<()> {
+    let artifact_path = match artifact {
+        Some(path) => {
+            let p = PathBuf::from(path);
+            if p.is_absolute() { p } else { project_path.join(p) }
+        }
+        None => find_latest_artifact(project_path)?,
+    };
+
+    if !artifact_path.exists() {
+        anyhow::bail!("产物不存在: {}", artifact_path.display());
+    }
+
+    let artifact_name = artifact_path
+        .file_name()
+        .map(|n| n.to_string_lossy().to_string())
+        .unwrap_or_else(|| artifact_path.display().to_string());
+    let artifact_size = fs::metadata(&artifact_path)?.len();
+    println!(
+        "{} 校验产物: {} ({})",
+        "[检查]".cyan().bold(),
+        artifact_name.cyan(),
+        format_size(artifact_size)
+    );
+
+    let report = verify_zip_streaming(&artifact_path)?;
+
+    println!(
+        "{} 中央目录: {} 个条目，解压总计 {}",
+        "[*]".blue().bold(),
+        report.entry_count,
+        format_size(report.uncompressed_bytes)
+    );
+
+    let mut problems: Vec<String> = Vec::new();
+
+    // 1. CRC 逐条目校验结果
+    if report.crc_failures.is_empty() {
+        println!("{} 所有条目 CRC 校验通过", "[✓]".green().bold());
+    } else {
+        for name in &report.crc_failures {
+            println!("{} CRC 校验失败: {}", "[✗]".red().bold(), name.red());
+            problems.push(format!("CRC 不匹配: {}", name));
+        }
+    }
+
+    // 2. 必需的模块布局
+    for required in REQUIRED_ENTRIES {
+        if report.entry_names.iter().any(|n| n == required) {
+            println!("{} 布局检查通过: {}", "[✓]".green().bold(), required);
+        } else {
+            println!("{} 缺少必需条目: {}", "[✗]".red().bold(), required.red());
+            problems.push(format!("缺少条目: {}", required));
+        }
+    }
+
+    // 3. module.prop 关键字段（只流式读这一个小条目）
+    if let Some(prop_content) = &report.module_prop {
+        for key in REQUIRED_PROP_KEYS {
+            let present = prop_content.lines().any(|line| {
+                line.split_once('=')
+                    .map(|(k, v)| k.trim() == *key && !v.trim().is_empty())
+                    .unwrap_or(false)
+            });
+            if present {
+                println!("{} module.prop 包含 {}", "[✓]".green().bold(), key);
+            } else {
+                println!("{} module.prop 缺少字段: {}", "[✗]".red().bold(), key.red());
+                problems.push(format!("module.prop 缺少字段: {}", key));
+            }
+        }
+    }
+
+    if problems.is_empty() {
+        println!("{} 产物校验通过: {}", "✅".green().bold(), artifact_name);
+        Ok(())
+    } else {
+        anyhow::bail!("产物校验失败（{} 个问题）: {}", problems.len(), problems.join("; "))
+    }
+}
+
+/// 流式校验报告
+struct VerifyReport {
+    entry_count: usize,
+    uncompressed_bytes: u64,
+    entry_names: Vec<String>,
+    crc_failures: Vec<String>,
+    /// module.prop 的文本内容（存在时）
+    module_prop: Option<String>,
+}
+
+/// 走 zip 中央目录，逐条目把解压流写入计数黑洞完成 CRC 校验
+///
+/// zip crate 的条目读取器在读到 EOF 时对照中央目录记录的 CRC32，
+/// 因此只要把字节流排空即可验证完整性，无需向磁盘写任何内容。
+fn verify_zip_streaming(artifact_path: &Path) -> Result<VerifyReport> {
+    let file = fs::File::open(artifact_path)
+        .with_context(|| format!("无法打开产物: {}", artifact_path.display()))?;
+    let mut archive = zip::ZipArchive::new(BufReader::new(file))
+        .with_context(|| format!("无法解析 zip 中央目录: {}", artifact_path.display()))?;
+
+    let mut report = VerifyReport {
+        entry_count: archive.len(),
+        uncompressed_bytes: 0,
+        entry_names: Vec::with_capacity(archive.len()),
+        crc_failures: Vec::new(),
+        module_prop: None,
+    };
+
+    for index in 0..archive.len() {
+        let mut entry = archive
+            .by_index(index)
+            .with_context(|| format!("无法读取第 {} 个条目", index))?;
+        let name = entry.name().to_string();
+        report.uncompressed_bytes += entry.size();
+
+        if entry.is_dir() {
+            report.entry_names.push(name);
+            continue;
+        }
+
+        if name == "module.prop" {
+            // module.prop 很小，顺便留下文本做字段检查（读取过程同样触发 CRC 校验）
+            let mut content = String::new();
+            match entry.read_to_string(&mut content) {
+                Ok(_) => report.module_prop = Some(content),
+                Err(_) => report.crc_failures.push(name.clone()),
+            }
+        } else if io::copy(&mut entry, &mut io::sink()).is_err() {
+            report.crc_failures.push(name.clone());
+        }
+
+        report.entry_names.push(name);
+    }
+
+    Ok(report)
+}
+
+/// 定位 .rmmp/dist 下最新修改的 zip 产物
+fn find_latest_artifact(project_path: &Path) -> Result<PathBuf> {
+    let dist_dir = project_path.join(".rmmp/dist");
+    if !dist_dir.exists() {
+        anyhow::bail!("dist 目录不存在，请先运行 rmm build: {}", dist_dir.display());
+    }
+
+    let mut newest: Option<(std::time::SystemTime, PathBuf)> = None;
+    for dir_entry in fs::read_dir(&dist_dir)? {
+        let dir_entry = dir_entry?;
+        let path = dir_entry.path();
+        if path.extension().and_then(|e| e.to_str()) != Some("zip") {
+            continue;
+        }
+        // 差量包不含完整模块布局，且总在全量包之后生成（mtime 更新），
+        // 自动选择时跳过，只校验全量产物
+        let file_name = path.file_name().and_then(|n| n.to_str()).unwrap_or("");
+        if file_name.ends_with(".delta.zip") {
+            continue;
+        }
+        let modified = dir_entry.metadata()?.modified()?;
+        if newest.as_ref().map(|(t, _)| modified > *t).unwrap_or(true) {
+            newest = Some((modified, path));
+        }
+    }
+
+    newest
+        .map(|(_, path)| path)
+        .ok_or_else(|| anyhow::anyhow!("dist 目录中没有 zip 产物: {}", dist_dir.display()))
+}
+
+/// 人类可读的字节数
+fn format_size(bytes: u64) -> String {
+    const UNITS: &[&str] = &["B", "KB", "MB", "GB"];
+    let mut size = bytes as f64;
+    let mut unit = 0;
+    while size >= 1024.0 && unit < UNITS.len() - 1 {
+        size /= 1024.0;
+        unit += 1;
+    }
+    if unit == 0 {
+        format!("{} {}", bytes, UNITS[unit])
+    } else {
+        format!("{:.2} {}", size, UNITS[unit])
+    }
+}
+
+#[cfg(test)]
+mod tests {    use super::*;
+    use std::io::Write;
+
+    /// 在内存里写一个合法的模块 zip，落到 dist 目录
+    fn write_module_zip(dist_dir: &Path, name: &str) -> PathBuf {
+        fs::create_dir_all(dist_dir).unwrap();
+        let zip_path = dist_dir.join(name);
+        let file = fs::File::create(&zip_path).unwrap();
+        let mut writer = zip::ZipWriter::new(file);
+        // Stored 便于测试按明文偏移定位并破坏数据区
+        let options = zip::write::SimpleFileOptions::default()
+            .compression_method(zip::CompressionMethod::Stored);
+
+        writer.start_file("module.prop", options).unwrap();
+        writer
+            .write_all(b"id=test_module\nname=Test Module\nversion=v1.0.0\nversionCode=1000000\n")
+            .unwrap();
+        writer
+            .start_file("META-INF/com/google/android/update-binary", options)
+            .unwrap();
+        writer.write_all(b"#!/sbin/sh\n").unwrap();
+        writer
+            .start_file("META-INF/com/google/android/updater-script", options)
+            .unwrap();
+        writer.write_all(b"#MAGISK\n").unwrap();
+        writer.finish().unwrap();
+        zip_path
+    }
+
+    #[test]
+    fn test_check_valid_artifact() {
+        let temp_dir = tempfile::tempdir().unwrap();
+        write_module_zip(&temp_dir.path().join(".rmmp/dist"), "test_module-1000000.zip");
+        assert!(check_artifact(temp_dir.path(), None).is_ok());
+    }
+
+    #[test]
+    fn test_auto_select_skips_delta_zip() {
+        let temp_dir = tempfile::tempdir().unwrap();
+        let dist_dir = temp_dir.path().join(".rmmp/dist");
+        let full_zip = write_module_zip(&dist_dir, "test_module-1000000.zip");
+
+        // 差量包在全量包之后写出（mtime 更新），自动选择仍应取全量包
+        std::thread::sleep(std::time::Duration::from_millis(20));
+        fs::write(dist_dir.join("test_module-999-to-1000000.delta.zip"), b"delta").unwrap();
+
+        let selected = find_latest_artifact(temp_dir.path()).unwrap();
+        assert_eq!(selected, full_zip);
+    }
+
+    #[test]
+    fn test_check_rejects_missing_layout() {
+        let temp_dir = tempfile::tempdir().unwrap();
+        let dist_dir = temp_dir.path().join(".rmmp/dist");
+        fs::create_dir_all(&dist_dir).unwrap();
+        let zip_path = dist_dir.join("broken-1.zip");
+        let file = fs::File::create(&zip_path).unwrap();
+        let mut writer = zip::ZipWriter::new(file);
+        let options = zip::write::SimpleFileOptions::default();
+        writer.start_file("README.md", options).unwrap();
+        writer.write_all(b"not a module\n").unwrap();
+        writer.finish().unwrap();
+
+        let result = check_artifact(temp_dir.path(), None);
+        assert!(result.is_err());
+        assert!(result.unwrap_err().to_string().contains("module.prop"));
+    }
+
+    #[test]
+    fn test_check_detects_crc_corruption() {
+        let temp_dir = tempfile::tempdir().unwrap();
+        let zip_path = write_module_zip(&temp_dir.path().join(".rmmp/dist"), "test_module-1000000.zip");
+
+        // 翻转压缩数据区的一个字节，制造 CRC 不匹配
+        let mut bytes = fs::read(&zip_path).unwrap();
+        let offset = bytes
+            .windows(4)
+            .position(|w| w == b"id=t")
+            .expect("应能在 stored 数据区找到 module.prop 内容");
+        bytes[offset] ^= 0xFF;
+        fs::write(&zip_path, bytes).unwrap();
+
+        let result = check_artifact(temp_dir.path(), None);
+        assert!(result.is_err());
+        assert!(result.unwrap_err().to_string().contains("CRC"));
+    }
+}
@@ -9,12 +9,19 @@ use serde_json;
 use git2::{Repository, Config};
 
 use crate::core::rmm_core::{
-    Author, BuildConfig, BuildSystem, ModuleProp, ProjectInfo, 
+    Author, BuildConfig, BuildSystem, ModuleProp, ProjectInfo,
     RmakeConfig, RmmProject, SrcConfig, UrlsInfo, GitAnalyzer, GitInfo
 };
 
-/// 初始化新的模块项目
+pub mod templates;
+
+/// 初始化新的模块项目（使用默认模板变体）
 pub fn init_project(project_path: &Path, project_id: &str, author: &str, email: &str) -> Result<()> {
+    init_project_with_template(project_path, project_id, author, email, templates::DEFAULT_VARIANT)
+}
+
+/// 初始化新的模块项目，静态文件来自编译期嵌入的模板包
+pub fn init_project_with_template(project_path: &Path, project_id: &str, author: &str, email: &str, template: &str) -> Result<()> {
     let project_path = project_path.canonicalize().unwrap_or_else(|_| project_path.to_path_buf());
       // 确保项目目录存在
     if !project_path.exists() {
@@ -32,6 +39,11 @@ pub fn init_project(project_path: &Path, project_id: &str, author: &str, email:
         anyhow::bail!("项目ID格式无效。必须以字母开头，只能包含字母、数字、点、下划线和连字符，且至少2个字符");
     }
 
+    // 解析模板变体（编译期嵌入，无运行时查找）
+    let bundle = templates::get_variant(template).ok_or_else(|| {
+        anyhow::anyhow!("未知的模板变体: {}。可用变体: {}", template, templates::variant_names().join(", "))
+    })?;
+
     // 获取智能用户信息
     let (smart_author, smart_email) = get_smart_user_info(author, email, &project_path)?;
 
@@ -82,14 +94,11 @@ pub fn init_project(project_path: &Path, project_id: &str, author: &str, email:
     // 5. 创建system目录
     create_system_structure(&project_path)?;
 
-    // 6. 创建customize.sh
-    create_customize_script(&project_path)?;
+    // 6. 批量释放嵌入模板包（customize.sh、文档及示例文件）
+    bundle.extract_into(&project_path, project_id)?;
 
     // 7. 创建update.json
-    create_update_json(&project_path, project_id, &git_info)?;
-
-    // 8. 创建其他推荐文件
-    create_documentation_files(&project_path, project_id)?;println!();
+    create_update_json(&project_path, project_id, &git_info)?;println!();
     println!("{} 模块项目初始化完成！", "🎉".green().bold());
     println!("{} 项目路径: {}", 
         "📁".cyan().bold(), 
@@ -222,6 +231,8 @@ fn create_rmake_config(project_path: &Path) -> Result<()> {
             prebuild: vec!["echo 'Starting build'".to_string()],
             build: vec!["rmm".to_string()],
             postbuild: vec!["echo 'Build completed'".to_string()],
+            compression: None,
+                source_format: None,
             src: Some(SrcConfig {
                 include: vec!["# 源代码额外包含的文件，如：\"docs/\"".to_string()],
                 exclude: vec![
@@ -389,11 +400,9 @@ fn create_module_prop(project_path: &Path, project_id: &str, author: &str, git_i
     Ok(())
 }
 
-/// 创建system目录结构
+/// 创建system目录结构（示例文件由嵌入模板包提供）
 fn create_system_structure(project_path: &Path) -> Result<()> {
     let system_dir = project_path.join("system");
-    let system_etc_dir = system_dir.join("etc");
-    let example_conf_path = system_etc_dir.join("example.conf");
 
     if system_dir.exists() {
         println!("{} 目录 {} 已存在，跳过创建。", "[!]".yellow().bold(), "system".cyan().bold());
@@ -401,251 +410,7 @@ fn create_system_structure(project_path: &Path) -> Result<()> {
         fs::create_dir_all(&system_dir)?;
         println!("{} 创建 {} 目录", "[+]".green().bold(), "system".cyan().bold());
     }
-    
-    // 创建一个示例目录和文件
-    if system_etc_dir.exists() {
-        println!("{} 目录 {} 已存在，跳过创建。", "[!]".yellow().bold(), "system/etc".cyan().bold());
-    } else {
-        fs::create_dir_all(&system_etc_dir)?;
-        println!("{} 创建 {} 目录", "[+]".green().bold(), "system/etc".cyan().bold());
-    }
-
-    if example_conf_path.exists() {
-        println!("{} 文件 {} 已存在，跳过创建。", "[!]".yellow().bold(), "system/etc/example.conf".cyan().bold());
-    } else {
-        fs::write(
-            &example_conf_path,
-            "# 这是一个示例配置文件\n# 将此文件放置在system目录中，它会被挂载到 /system/etc/example.conf\n"
-        )?;
-        println!("{} 创建 {} 文件", "[+]".green().bold(), "system/etc/example.conf".cyan().bold());
-    }
-
-    Ok(())
-}
-
-/// 创建customize.sh安装脚本
-fn create_customize_script(project_path: &Path) -> Result<()> {
-    let customize_script_path = project_path.join("customize.sh");
-    
-    if customize_script_path.exists() {
-        println!("{} 文件 {} 已存在，跳过创建。", "[!]".yellow().bold(), "customize.sh".cyan().bold());
-        return Ok(());
-    }
-
-    let customize_script = r#"#!/system/bin/sh
-# KernelSU 模块自定义安装脚本
-
-# 检查设备信息
-ui_print "- 设备架构: $ARCH"
-ui_print "- Android API: $API"
-ui_print "- KernelSU 版本: $KSU_VER"
-
-# 根据设备架构进行不同的处理
-case $ARCH in
-    arm64)
-        ui_print "- 64位ARM设备"
-        ;;
-    arm)
-        ui_print "- 32位ARM设备"
-        ;;
-    x64)
-        ui_print "- x86_64设备"
-        ;;
-    x86)
-        ui_print "- x86设备"
-        ;;
-esac
-
-# 根据Android版本进行处理
-# 示例shellcheck 自动修复 $API -> "$API"
-if [ $API -lt 29 ]; then
-    ui_print "- Android 10以下版本"
-else
-    ui_print "- Android 10及以上版本"
-fi
-
-# 设置权限（如果需要）
-# set_perm_recursive $MODPATH/system/bin 0 0 0755 0755
-# set_perm $MODPATH/system/etc/example.conf 0 0 0644
-
-# 示例：删除系统文件（取消注释以使用）
-# REMOVE="
-# /system/app/SomeSystemApp
-# /system/etc/some_config_file
-# "
-
-# 示例：替换系统目录（取消注释以使用）
-# REPLACE="
-# /system/app/SomeSystemApp
-# "
-
-ui_print "- 模块安装完成"
-"#;
-
-    fs::write(&customize_script_path, customize_script)?;
-    
-    // 设置可执行权限（仅在Unix系统上）
-    #[cfg(unix)]
-    {
-        use std::os::unix::fs::PermissionsExt;
-        let mut perms = fs::metadata(&customize_script_path)?.permissions();
-        perms.set_mode(0o755);
-        fs::set_permissions(&customize_script_path, perms)?;
-    }
-    
-    println!("{} 创建 {}", 
-        "[+]".green().bold(), 
-        "customize.sh".cyan().bold()
-    );
-    Ok(())
-}
-
-/// 创建文档文件
-fn create_documentation_files(project_path: &Path, project_id: &str) -> Result<()> {
-    create_readme(project_path, project_id)?;
-    create_changelog(project_path)?;
-    create_license(project_path)?;
-    Ok(())
-}
-
-/// 创建README.md文件
-fn create_readme(project_path: &Path, project_id: &str) -> Result<()> {
-    let readme_path = project_path.join("README.md");
-    
-    if readme_path.exists() {
-        println!("{} 文件 {} 已存在，跳过创建。", "[!]".yellow().bold(), "README.md".cyan().bold());
-        return Ok(());
-    }
-
-    let readme_content = format!(r#"# {} Module
-
-这是一个 rmm 模块项目。
-
-## 说明
-
-RMMP ID: {}
-
-## 安装
-
-1. 使用 ROOT 管理器安装此模块
-2. 重启设备
-
-## 开发
-
-```bash
-# 构建模块
-rmm build
 
-# 安装到设备
-rmm device install
-
-# 运行测试
-rmm test
-```
-
-## 文件结构
-
-```
-{}
-├── .rmmp/              # RMM 项目文件
-│   ├── Rmake.toml     # 构建配置
-│   ├── build/         # 构建输出
-│   └── dist/          # 发布文件
-├── system/            # 系统文件覆盖
-├── module.prop        # 模块属性
-├── customize.sh       # 安装脚本
-├── rmmproject.toml    # 项目配置
-└── README.md          # 说明文档
-```
-
-## 许可证
-
-见 LICENSE 文件。
-"#, 
-        project_id.chars().next().unwrap().to_uppercase().to_string() + &project_id[1..],
-        project_id, 
-        project_id
-    );
-
-    fs::write(&readme_path, readme_content)?;
-    println!("{} 创建 {}", 
-        "[+]".green().bold(), 
-        "README.md".cyan().bold()
-    );
-    Ok(())
-}
-
-/// 创建CHANGELOG.md文件
-fn create_changelog(project_path: &Path) -> Result<()> {
-    let changelog_path = project_path.join("CHANGELOG.md");
-    
-    if changelog_path.exists() {
-        println!("{} 文件 {} 已存在，跳过创建。", "[!]".yellow().bold(), "CHANGELOG.md".cyan().bold());
-        return Ok(());
-    }
-
-    let changelog_content = r#"# 更新日志
-
-### 新增
-- 初始版本
-- 基本模块功能
-
-### 修复
-- 无
-
-### 更改
-- 无
-"#;
-
-    fs::write(&changelog_path, changelog_content)?;
-    println!("{} 创建 {}", 
-        "[+]".green().bold(), 
-        "CHANGELOG.md".cyan().bold()
-    );
-    Ok(())
-}
-
-/// 创建LICENSE文件
-fn create_license(project_path: &Path) -> Result<()> {
-    let license_path = project_path.join("LICENSE");
-    
-    if license_path.exists() {
-        println!("{} 文件 {} 已存在，跳过创建。", "[!]".yellow().bold(), "LICENSE".cyan().bold());
-        return Ok(());
-    }
-
-    let license_content = r#"#在此处添加你的许可证
-    
-# 请不要移除以下许可信息
-MIT License
-
-Copyright (c) 2025 LIghtJUNction
-
-Permission is hereby granted, free of charge, to any person obtaining a copy
-of this software and associated documentation files (the "Software"), to deal
-in the Software without restriction, including without limitation the rights
-to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
-copies of the Software, and to permit persons to whom the Software is
-furnished to do so, subject to the following conditions:
-
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
-
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
-
-"#;
-
-    fs::write(&license_path, license_content)?;
-    println!("{} 创建 {}", 
-        "[+]".green().bold(), 
-        "LICENSE".cyan().bold()
-    );
     Ok(())
 }
 
@@ -0,0 +1,105 @@
+use anyhow::Result;
+use std::collections::BTreeSet;
+use std::fs;
+use std::path::Path;
+use colored::*;
+
+/// 编译期嵌入的脚手架模板包：所有静态模板文件通过 include_str! 打进二进制，
+/// init 在锁定网络的构建机上也能全离线完成，且无需在运行时查找模板目录
+pub struct TemplateBundle {
+    pub name: &'static str,
+    pub description: &'static str,
+    /// (项目内相对路径, 模板内容)
+    files: &'static [(&'static str, &'static str)],
+}
+
+/// 默认模板变体
+pub const DEFAULT_VARIANT: &str = "basic";
+
+/// 所有可用的模板变体
+pub const TEMPLATE_VARIANTS: &[TemplateBundle] = &[
+    TemplateBundle {
+        name: "basic",
+        description: "标准模板：完整的 customize.sh、示例 system 文件和文档",
+        files: &[
+            ("customize.sh", include_str!("../../../templates/basic/customize.sh")),
+            ("README.md", include_str!("../../../templates/basic/README.md")),
+            ("CHANGELOG.md", include_str!("../../../templates/basic/CHANGELOG.md")),
+            ("LICENSE", include_str!("../../../templates/basic/LICENSE")),
+            ("system/etc/example.conf", include_str!("../../../templates/basic/system/etc/example.conf")),
+        ],
+    },
+    TemplateBundle {
+        name: "minimal",
+        description: "最小模板：只有必要文件，不带示例 system 内容",
+        files: &[
+            ("customize.sh", include_str!("../../../templates/minimal/customize.sh")),
+            ("README.md", include_str!("../../../templates/minimal/README.md")),
+            ("CHANGELOG.md", include_str!("../../../templates/minimal/CHANGELOG.md")),
+            ("LICENSE", include_str!("../../../templates/minimal/LICENSE")),
+        ],
+    },
+];
+
+/// 按名称查找模板变体
+pub fn get_variant(name: &str) -> Option<&'static TemplateBundle> {
+    TEMPLATE_VARIANTS.iter().find(|bundle| bundle.name == name)
+}
+
+/// 列出所有变体名称（用于错误提示）
+pub fn variant_names() -> Vec<&'static str> {
+    TEMPLATE_VARIANTS.iter().map(|bundle| bundle.name).collect()
+}
+
+impl TemplateBundle {
+    /// 渲染模板内容：替换 {{PROJECT_ID}} / {{PROJECT_ID_TITLE}} 占位符
+    fn render(content: &str, project_id: &str) -> String {
+        let title = match project_id.chars().next() {
+            Some(first) => first.to_uppercase().to_string() + &project_id[first.len_utf8()..],
+            None => project_id.to_string(),
+        };
+        content
+            .replace("{{PROJECT_ID_TITLE}}", &title)
+            .replace("{{PROJECT_ID}}", project_id)
+    }
+
+    /// 将整个模板包批量写入项目目录：先一次性创建所有父目录，
+    /// 再逐个写文件；已存在的文件跳过，与旧的逐文件初始化行为一致
+    pub fn extract_into(&self, project_path: &Path, project_id: &str) -> Result<usize> {
+        // 收集去重后的父目录，避免对同一目录重复 create_dir_all
+        let mut parent_dirs = BTreeSet::new();
+        for (rel_path, _) in self.files {
+            if let Some(parent) = Path::new(rel_path).parent() {
+                if !parent.as_os_str().is_empty() {
+                    parent_dirs.insert(project_path.join(parent));
+                }
+            }
+        }
+        for dir in &parent_dirs {
+            fs::create_dir_all(dir)?;
+        }
+
+        let mut written = 0;
+        for (rel_path, content) in self.files {
+            let target = project_path.join(rel_path);
+            if target.exists() {
+                println!("{} 文件 {} 已存在，跳过创建。", "[!]".yellow().bold(), rel_path.cyan().bold());
+                continue;
+            }
+            fs::write(&target, Self::render(content, project_id))?;
+
+            // customize.sh 需要可执行权限（仅在Unix系统上）
+            #[cfg(unix)]
+            if rel_path.ends_with(".sh") {
+                use std::os::unix::fs::PermissionsExt;
+                let mut perms = fs::metadata(&target)?.permissions();
+                perms.set_mode(0o755);
+                fs::set_permissions(&target, perms)?;
+            }
+
+            println!("{} 创建 {}", "[+]".green().bold(), rel_path.cyan().bold());
+            written += 1;
+        }
+        Ok(written)
+    }
+}
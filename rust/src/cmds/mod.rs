@@ -3,6 +3,7 @@ pub mod init;
 pub mod build;
 pub mod run;
 pub mod sync;
+pub mod check;
 
 pub use rmmbox::RmmBox;
 
@@ -15,6 +16,10 @@ pub enum Commands {
     Init {
         /// 项目ID（同时作为文件夹名）
         project_id: String,
+
+        /// 模板变体（basic / minimal），模板编译期嵌入二进制，离线可用
+        #[arg(short, long, default_value = "basic")]
+        template: String,
     },    /// 🔨 构建模块项目
     Build {
         /// 项目路径（可选，默认为当前目录）
@@ -24,7 +29,31 @@ pub enum Commands {
         /// 禁用 shellcheck 自动修复（默认启用自动修复）
         #[arg(long, default_value = "false")]
         no_auto_fix: bool,
-        
+
+        /// 增量构建：只重新处理内容发生变化的文件
+        #[arg(long, default_value = "false")]
+        incremental: bool,
+
+        /// 流式打包：直接从源文件写 zip，跳过 .rmmp/build 暂存树
+        #[arg(long, default_value = "false")]
+        streaming: bool,
+
+        /// 监视模式：常驻进程，文件变化时自动增量重建
+        #[arg(long, default_value = "false")]
+        watch: bool,
+
+        /// 输出各构建阶段的耗时报告（并导出 chrome-trace JSON）
+        #[arg(long, default_value = "false")]
+        timings: bool,
+
+        /// 批量模式：构建 meta.toml 中注册的所有项目
+        #[arg(long, default_value = "false")]
+        all: bool,
+
+        /// 批量模式的并发任务数（默认取 CPU 核数与项目数的较小值）
+        #[arg(short, long)]
+        jobs: Option<usize>,
+
         /// 运行 Rmake.toml 中定义的脚本
         #[arg(value_name = "SCRIPT")]
         script: Option<String>,    },
@@ -39,6 +68,17 @@ pub enum Commands {
         script: Option<String>,
     },
     
+    /// 🔍 流式校验构建产物（CRC 与模块布局，不解压落盘）
+    Check {
+        /// 项目路径（可选，默认为当前目录）
+        #[arg(short, long)]
+        project_path: Option<String>,
+
+        /// 产物 zip 路径（省略则取 .rmmp/dist 下最新产物）
+        #[arg(value_name = "ARTIFACT")]
+        artifact: Option<String>,
+    },
+
     /// 🔄 同步项目元数据
     Sync {
         /// 特定项目名称（可选，默认同步所有项目）
@@ -58,6 +98,9 @@ pub enum Commands {
         max_depth: Option<usize>,
     },
     
+    /// 📊 输出缓存观测指标（JSON 格式）
+    CacheStats,
+
     /// 显示版本信息
     Version,
     
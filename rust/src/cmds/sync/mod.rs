@@ -7,6 +7,60 @@ use std::collections::HashMap;
 
 use crate::core::rmm_core::{RmmCore, GitAnalyzer, MetaConfig};
 
+/// 一次 sync 运行内共享的 git 快照：每个仓库只打开一次，
+/// HEAD 短 hash 和 user.name/email 只读一次，monorepo 里共享同一仓库的
+/// 多个项目全部命中缓存，git 开销与项目数无关
+#[derive(Debug, Clone)]
+struct GitSnapshot {
+    /// HEAD 完整 OID（版本索引的键）
+    head_oid: Option<String>,
+    /// HEAD 短 hash（版本号 patch 部分）
+    head_short: Option<String>,
+    author: Option<AuthorInfo>,
+}
+
+impl GitSnapshot {
+    /// 按仓库根目录缓存的快照表（并行同步阶段各线程共享）
+    fn cache() -> &'static std::sync::Mutex<HashMap<PathBuf, GitSnapshot>> {
+        static CACHE: std::sync::OnceLock<std::sync::Mutex<HashMap<PathBuf, GitSnapshot>>> =
+            std::sync::OnceLock::new();
+        CACHE.get_or_init(|| std::sync::Mutex::new(HashMap::new()))
+    }
+
+    /// 获取路径所属仓库的快照；不在 git 仓库中时返回 None
+    fn for_path(path: &Path) -> Option<GitSnapshot> {
+        let repo_root = GitAnalyzer::find_git_root(path).ok().flatten()?;
+
+        if let Some(snapshot) = Self::cache().lock().unwrap().get(&repo_root) {
+            return Some(snapshot.clone());
+        }
+
+        let snapshot = match git2::Repository::open(&repo_root) {
+            Ok(repo) => {
+                let head_oid = repo
+                    .head()
+                    .ok()
+                    .and_then(|head| head.target())
+                    .map(|oid| oid.to_string());
+                let head_short = head_oid
+                    .as_ref()
+                    .filter(|s| s.len() >= 8)
+                    .map(|s| s[..8].to_string());
+                let author = repo.config().ok().and_then(|config| {
+                    let name = config.get_string("user.name").ok()?;
+                    let email = config.get_string("user.email").ok()?;
+                    Some(AuthorInfo { name, email })
+                });
+                GitSnapshot { head_oid, head_short, author }
+            }
+            Err(_) => GitSnapshot { head_oid: None, head_short: None, author: None },
+        };
+
+        Self::cache().lock().unwrap().insert(repo_root, snapshot.clone());
+        Some(snapshot)
+    }
+}
+
 /// 作者信息
 #[derive(Debug, Clone, PartialEq)]
 struct AuthorInfo {
@@ -16,23 +70,92 @@ struct AuthorInfo {
 
 impl AuthorInfo {
     fn is_default(&self) -> bool {
-        self.name == "unknown" || self.name == "test" || 
+        self.name == "unknown" || self.name == "test" ||
         self.email == "unknown@example.com" || self.email == "test@example.com" ||
         self.name.is_empty() || self.email.is_empty()
     }
-    
+
     fn from_git(path: &Path) -> Option<Self> {
-        GitAnalyzer::analyze_git_info(path).ok().flatten().and_then(|git_info| {
-            // 从 git config 获取用户信息
-            if let Ok(repo) = git2::Repository::open(&git_info.repo_root) {
-                let config = repo.config().ok()?;
-                let name = config.get_string("user.name").ok()?;
-                let email = config.get_string("user.email").ok()?;
-                Some(AuthorInfo { name, email })
-            } else {
-                None
-            }
-        })
+        GitSnapshot::for_path(path)?.author
+    }
+}
+
+/// 版本代码持久索引（RMM_ROOT/version-code.index.json）
+///
+/// 键为 "HEAD OID::项目绝对路径"。HEAD 未移动时上次算出的版本
+/// 仍然有效，sync 直接复用索引结果，整段跳过版本重算；
+/// 内存侧按索引文件路径缓存，与 GitSnapshot 一样跨并行线程共享。
+#[derive(Debug, Default, Clone, serde::Serialize, serde::Deserialize)]
+struct VersionCodeIndex {
+    entries: HashMap<String, VersionIndexEntry>,
+}
+
+/// 索引条目：某 (HEAD, 项目) 组合下最后写入 module.prop 的版本
+#[derive(Debug, Clone, PartialEq, serde::Serialize, serde::Deserialize)]
+struct VersionIndexEntry {
+    version: String,
+    version_code: String,
+}
+
+impl VersionCodeIndex {
+    /// 按索引文件路径缓存的内存表（load 一次，record 时同步写回）
+    fn cache() -> &'static std::sync::Mutex<HashMap<PathBuf, VersionCodeIndex>> {
+        static CACHE: std::sync::OnceLock<std::sync::Mutex<HashMap<PathBuf, VersionCodeIndex>>> =
+            std::sync::OnceLock::new();
+        CACHE.get_or_init(|| std::sync::Mutex::new(HashMap::new()))
+    }
+
+    fn index_path(core: &RmmCore) -> PathBuf {
+        core.get_rmm_root().join("version-code.index.json")
+    }
+
+    fn key(head_oid: &str, project_path: &Path) -> String {
+        format!("{}::{}", head_oid, normalize_path(project_path))
+    }
+
+    /// 查索引：命中返回上次记录的版本条目
+    fn lookup(core: &RmmCore, head_oid: &str, project_path: &Path) -> Option<VersionIndexEntry> {
+        let index_path = Self::index_path(core);
+        let mut cache = Self::cache().lock().unwrap();
+        let index = cache
+            .entry(index_path.clone())
+            .or_insert_with(|| Self::load_from(&index_path));
+        index.entries.get(&Self::key(head_oid, project_path)).cloned()
+    }
+
+    /// 记录本次写入的版本并落盘（索引文件很小，顺手写回即可）
+    fn record(core: &RmmCore, head_oid: &str, project_path: &Path, version_info: &VersionInfo) {
+        let index_path = Self::index_path(core);
+        let mut cache = Self::cache().lock().unwrap();
+        let index = cache
+            .entry(index_path.clone())
+            .or_insert_with(|| Self::load_from(&index_path));
+        index.entries.insert(
+            Self::key(head_oid, project_path),
+            VersionIndexEntry {
+                version: version_info.version.clone(),
+                version_code: version_info.version_code.clone(),
+            },
+        );
+        if let Err(e) = index.save_to(&index_path) {
+            println!("    ⚠️  写入版本索引失败: {}", e.to_string().yellow());
+        }
+    }
+
+    /// 读取索引文件，文件不存在或损坏时从空索引开始
+    fn load_from(index_path: &Path) -> Self {
+        fs::read_to_string(index_path)
+            .ok()
+            .and_then(|content| serde_json::from_str(&content).ok())
+            .unwrap_or_default()
+    }
+
+    fn save_to(&self, index_path: &Path) -> Result<()> {
+        if let Some(parent) = index_path.parent() {
+            fs::create_dir_all(parent)?;
+        }
+        fs::write(index_path, serde_json::to_string_pretty(self)?)?;
+        Ok(())
     }
 }
 
@@ -63,11 +186,18 @@ impl VersionInfo {
     }
       /// 智能版本升级 - 支持基于日期和Git的版本管理
     fn smart_bump_version(&mut self, project_path: &Path) {
+        self.smart_bump_version_with(project_path, None);
+    }
+
+    /// 智能版本升级，可复用批量预解析阶段算好的版本代码
+    fn smart_bump_version_with(&mut self, project_path: &Path, precomputed_code: Option<&str>) {
         // 使用智能版本升级
         self.version = smart_version_bump(&self.version, project_path);
-        
-        // 生成新的版本代码
-        self.version_code = generate_version_code(project_path);
+
+        // 生成新的版本代码（预解析结果存在时直接复用，不再重算）
+        self.version_code = precomputed_code
+            .map(str::to_string)
+            .unwrap_or_else(|| generate_version_code(project_path));
     }
     
     /// 传统版本升级（保留兼容性）
@@ -171,7 +301,8 @@ fn sync_specific_project(core: &RmmCore, project_name: &str) -> Result<()> {
         } else {
             println!("  ❌ 项目 {} 无效，从 meta 中移除", project_name.red());
             meta.projects.remove(project_name);
-            core.update_meta_config(&meta)?;
+            // 点更新：走 meta 日志，不重写整个 meta.toml
+            core.remove_project_from_meta(project_name)?;
         }
     } else {
         println!("  ❓ 项目 {} 不存在于 meta.toml 中", project_name.yellow());
@@ -196,8 +327,10 @@ fn search_and_add_project(core: &RmmCore, project_name: &str, meta: &mut crate::
             for project in found_projects {
                 if project.name == project_name {
                     println!("  🔍 找到项目: {}", project.path.display().to_string().green());
-                    meta.projects.insert(project.name, project.path.display().to_string());
-                    core.update_meta_config(meta)?;
+                    let path_str = project.path.display().to_string();
+                    // 点更新：走 meta 日志，不重写整个 meta.toml
+                    core.set_project_in_meta(&project.name, &path_str)?;
+                    meta.projects.insert(project.name, path_str);
                     return Ok(());
                 }
             }
@@ -208,16 +341,25 @@ fn search_and_add_project(core: &RmmCore, project_name: &str, meta: &mut crate::
 
 /// 同步项目元数据（版本、作者信息等）
 fn sync_project_metadata(core: &RmmCore, project_path: &Path, meta: &mut crate::core::rmm_core::MetaConfig) -> Result<()> {
+    sync_project_metadata_with(core, project_path, meta, true, None)
+}
+
+/// 同步项目元数据
+///
+/// write_meta 为 false 时作者同步只更新内存中的 meta 副本，不写 meta.toml，
+/// 供并行同步阶段使用（最终由调用方一次性写入）。
+/// precomputed_code 为批量预解析阶段算好的版本代码，避免重复的 git 遍历。
+fn sync_project_metadata_with(core: &RmmCore, project_path: &Path, meta: &mut crate::core::rmm_core::MetaConfig, write_meta: bool, precomputed_code: Option<&str>) -> Result<()> {
     println!("  🔄 同步项目元数据...");
       // 1. 版本管理
     println!("    📦 检查版本信息...");
-    if let Err(e) = sync_version_info(core, project_path) {
+    if let Err(e) = sync_version_info(core, project_path, meta, write_meta, precomputed_code) {
         println!("    ⚠️  版本同步失败: {}", e.to_string().yellow());
     }
-    
+
     // 2. 作者信息同步
     println!("    👤 检查作者信息...");
-    if let Err(e) = sync_author_info(core, project_path, meta) {
+    if let Err(e) = sync_author_info(core, project_path, meta, write_meta) {
         println!("    ⚠️  作者信息同步失败: {}", e.to_string().yellow());
     }
     
@@ -245,33 +387,60 @@ fn sync_project_metadata(core: &RmmCore, project_path: &Path, meta: &mut crate::
 }
 
 /// 同步版本信息
-fn sync_version_info(core: &RmmCore, project_path: &Path) -> Result<()> {
+///
+/// 全局版本的比较与更新都针对传入的 meta 内存副本进行；write_meta 为
+/// false 时（并行同步阶段）不写 meta.toml，由主线程合并后一次性写入。
+/// precomputed_code 存在时跳过版本代码的重新生成。
+fn sync_version_info(core: &RmmCore, project_path: &Path, meta: &mut MetaConfig, write_meta: bool, precomputed_code: Option<&str>) -> Result<()> {
     if let Ok(mut version_info) = VersionInfo::from_module_prop(project_path) {
         println!("    📦 当前版本: {} ({})", version_info.version.bright_green(), version_info.version_code.bright_black());
-        
+
+        // 索引命中：HEAD 未移动且 module.prop 仍是上次写入的版本，整段跳过重算
+        let head_oid = GitSnapshot::for_path(project_path).and_then(|snapshot| snapshot.head_oid);
+        if let Some(oid) = &head_oid {
+            if let Some(entry) = VersionCodeIndex::lookup(core, oid, project_path) {
+                if entry.version == version_info.version && entry.version_code == version_info.version_code {
+                    println!("    ⚡ 版本索引命中（HEAD 未移动），跳过版本重算");
+                    if let Err(e) = sync_global_version(core, &version_info.version, meta, write_meta) {
+                        println!("    ⚠️  检查全局版本失败: {}", e.to_string().yellow());
+                    }
+                    return Ok(());
+                }
+            }
+        }
+
         // 执行智能版本升级
         let old_version = version_info.version.clone();
         let old_code = version_info.version_code.clone();
-        
-        version_info.smart_bump_version(project_path);
-        
+
+        version_info.smart_bump_version_with(project_path, precomputed_code);
+
         // 检查是否有变化
         if version_info.version != old_version || version_info.version_code != old_code {
             version_info.update_module_prop(project_path)?;
             sync_update_json(project_path, &version_info)?;
-            println!("    🆙 版本已升级: {} ({}) -> {} ({})", 
+            println!("    🆙 版本已升级: {} ({}) -> {} ({})",
                 old_version.bright_black(), old_code.bright_black(),
                 version_info.version.bright_green(), version_info.version_code.bright_green());
-            
+
+            // 记录到索引：同一 HEAD 下的后续 sync 不再重算
+            if let Some(oid) = &head_oid {
+                VersionCodeIndex::record(core, oid, project_path, &version_info);
+            }
+
             // 同步全局版本到meta.toml
-            if let Err(e) = sync_global_version(core, &version_info.version) {
+            if let Err(e) = sync_global_version(core, &version_info.version, meta, write_meta) {
                 println!("    ⚠️  更新全局版本失败: {}", e.to_string().yellow());
             }
         } else {
+            // 结果与现状一致也记录索引，下次直接命中
+            if let Some(oid) = &head_oid {
+                VersionCodeIndex::record(core, oid, project_path, &version_info);
+            }
             println!("    ℹ️  版本无需升级");
             
             // 即使版本不升级，也确保全局版本是同步的
-            if let Err(e) = sync_global_version(core, &version_info.version) {
+            if let Err(e) = sync_global_version(core, &version_info.version, meta, write_meta) {
                 println!("    ⚠️  检查全局版本失败: {}", e.to_string().yellow());
             }
         }
@@ -280,7 +449,7 @@ fn sync_version_info(core: &RmmCore, project_path: &Path) -> Result<()> {
 }
 
 /// 同步作者信息
-fn sync_author_info(core: &RmmCore, project_path: &Path, meta: &mut crate::core::rmm_core::MetaConfig) -> Result<()> {
+fn sync_author_info(core: &RmmCore, project_path: &Path, meta: &mut crate::core::rmm_core::MetaConfig, write_meta: bool) -> Result<()> {
     // 获取各来源的作者信息
     let meta_author = AuthorInfo {
         name: meta.username.clone(),
@@ -304,8 +473,8 @@ fn sync_author_info(core: &RmmCore, project_path: &Path, meta: &mut crate::core:
     let git_author = AuthorInfo::from_git(project_path);
     
     // 应用同步逻辑
-    apply_author_sync_logic(&meta_author, &project_author, &git_author, core, project_path, meta)?;
-    
+    apply_author_sync_logic(&meta_author, &project_author, &git_author, core, project_path, meta, write_meta)?;
+
     Ok(())
 }
 
@@ -316,9 +485,10 @@ fn apply_author_sync_logic(
     git_author: &Option<AuthorInfo>,
     core: &RmmCore,
     project_path: &Path,
-    meta: &mut crate::core::rmm_core::MetaConfig
+    meta: &mut crate::core::rmm_core::MetaConfig,
+    write_meta: bool,
 ) -> Result<()> {
-    
+
     let meta_is_default = meta_author.is_default();
     let project_is_default = project_author.is_default();
     
@@ -332,7 +502,9 @@ fn apply_author_sync_logic(
                 // 更新 meta 配置
                 meta.username = git_info.name.clone();
                 meta.email = git_info.email.clone();
-                core.update_meta_config(meta)?;
+                if write_meta {
+                    core.update_meta_config(meta)?;
+                }
                 
                 // 更新项目配置（这里需要实现更新项目配置的逻辑）
                 println!("    💡 建议手动更新项目配置以同步作者信息");
@@ -351,7 +523,9 @@ fn apply_author_sync_logic(
             
             meta.username = project_author.name.clone();
             meta.email = project_author.email.clone();
-            core.update_meta_config(meta)?;
+            if write_meta {
+                core.update_meta_config(meta)?;
+            }
         },
         (false, true) => {
             // meta 不是默认值，项目是 - 将 meta 信息同步到项目
@@ -433,38 +607,39 @@ fn sync_all_projects(
     let max_depth = max_depth.unwrap_or(3);
     let mut new_projects_count = 0;
     let mut total_scanned = 0;
-    
+
+    // 先顺序完成扫描和 meta 项目表的内存更新，收集需要同步元数据的项目
+    let mut meta = core.get_meta_config()?;
+    let mut path_updates = 0;
+    let mut projects_to_sync: Vec<(String, std::path::PathBuf)> = Vec::new();
+
     for search_path in &search_paths {
         if !search_path.exists() {
             println!("  ⚠️  路径不存在: {}", search_path.display().to_string().yellow());
             continue;
         }
-        
-        println!("  📂 扫描路径: {} (深度: {})", 
-                 search_path.display().to_string().cyan(), 
+
+        println!("  📂 扫描路径: {} (深度: {})",
+                 search_path.display().to_string().cyan(),
                  max_depth.to_string().bright_white());
-        
+
         match core.scan_projects(search_path.as_path(), Some(max_depth)) {
             Ok(found_projects) => {
                 total_scanned += found_projects.len();
-                
-                // 获取当前 meta 配置
-                let mut meta = core.get_meta_config()?;
-                let mut path_updates = 0;
-                
+
                 for project in found_projects {
                     let project_name = &project.name;
                     let project_path = &project.path;
                       if let Some(existing_path) = meta.projects.get(project_name) {                        // 项目已存在，检查路径是否需要更新
                         let normalized_path = normalize_path(project_path);
-                        
+
                         // 防止空路径
                         let safe_path = if normalized_path.is_empty() {
                             ".".to_string()
                         } else {
                             normalized_path
                         };
-                        
+
                         if existing_path != &safe_path {
                             println!("    🔄 更新项目路径: {}", project_name.yellow());
                             println!("      旧路径: {}", existing_path.bright_black());
@@ -472,23 +647,18 @@ fn sync_all_projects(
                             meta.projects.insert(project_name.clone(), safe_path);
                             path_updates += 1;
                         }
-                        
-                        // 为现有项目执行元数据同步
-                        if !projects_only {
-                            println!("    🔄 同步项目 {} 的元数据", project_name.cyan());
-                            if let Err(e) = sync_project_metadata(core, project_path, &mut meta) {
-                                println!("    ⚠️  同步失败: {}", e.to_string().yellow());
-                            }
-                        }                    } else {                        // 新项目 - 检查是否与现有项目路径重复
+
+                        projects_to_sync.push((project_name.clone(), project_path.clone()));
+                    } else {                        // 新项目 - 检查是否与现有项目路径重复
                         let normalized_path = normalize_path(project_path);
-                        
+
                         // 防止空路径
                         let safe_path = if normalized_path.is_empty() {
                             ".".to_string()
                         } else {
                             normalized_path
                         };
-                        
+
                         let is_duplicate_path = meta.projects.values().any(|existing_path| {
                             // 标准化路径比较
                             let existing_canonical = std::path::Path::new(existing_path)
@@ -498,43 +668,98 @@ fn sync_all_projects(
                                 .unwrap_or_else(|_| project_path.clone());
                             existing_canonical == new_canonical
                         });
-                        
+
                         if is_duplicate_path {
                             println!("    ⚠️  跳过重复路径的项目: {} -> {}", project_name.yellow(), safe_path.bright_black());
                             continue;
                         }
-                        
+
                         // 真正的新项目
                         println!("    ➕ 发现新项目: {}", project_name.green().bold());
                         println!("      路径: {}", safe_path.bright_black());
                         meta.projects.insert(project_name.clone(), safe_path);
                         new_projects_count += 1;
-                        
-                        // 为新项目也执行元数据同步
-                        if !projects_only {
-                            println!("    🔄 同步新项目 {} 的元数据", project_name.cyan());
-                            if let Err(e) = sync_project_metadata(core, project_path, &mut meta) {
-                                println!("    ⚠️  同步失败: {}", e.to_string().yellow());
-                            }
-                        }
+
+                        projects_to_sync.push((project_name.clone(), project_path.clone()));
                     }
                 }
-                
-                // 更新 meta 配置
-                if new_projects_count > 0 || path_updates > 0 {
-                    core.update_meta_config(&meta)?;
-                }
-                
-                if path_updates > 0 {
-                    println!("    🔄 更新了 {} 个项目路径", path_updates);
-                }
             }
             Err(e) => {
                 println!("  ❌ 扫描失败: {}", e.to_string().red());
             }
         }
     }
-    
+
+    // 同一个项目可能被多个搜索路径命中，去重后再同步
+    {
+        let mut seen = std::collections::HashSet::new();
+        projects_to_sync.retain(|(name, _)| seen.insert(name.clone()));
+    }
+
+    // 并行同步各项目的元数据：项目间相互独立，meta 的合并在主线程完成
+    let mut author_changed = false;
+    let mut version_changed = false;
+    if !projects_to_sync.is_empty() {
+        use rayon::prelude::*;
+
+        println!("{} 并行同步 {} 个项目的元数据...", "[🔄]".blue().bold(),
+                 projects_to_sync.len().to_string().bright_white());
+
+        // 批量预解析版本代码：一次仓库遍历预热 git 快照与版本索引，
+        // HEAD 未移动的项目在随后的逐项目同步中直接走索引快路径
+        let resolved = resolve_version_codes(core, &projects_to_sync);
+        let index_hits = resolved.values().filter(|(_, hit)| *hit).count();
+        println!("  ⚡ 版本索引命中: {}/{} 个项目", index_hits, resolved.len());
+
+        let meta_snapshot = meta.clone();
+        let sync_results: Vec<(String, std::time::Duration, Result<crate::core::rmm_core::MetaConfig>)> =
+            projects_to_sync
+                .par_iter()
+                .map(|(name, path)| {
+                    let start = std::time::Instant::now();
+                    let mut local_meta = meta_snapshot.clone();
+                    // 预解析阶段算好的版本代码直接下发，冷路径不再重算
+                    let precomputed_code = resolved.get(name).map(|(code, _)| code.as_str());
+                    // write_meta = false：并行阶段不触碰 meta.toml，只改内存副本
+                    let result = sync_project_metadata_with(core, path, &mut local_meta, false, precomputed_code)
+                        .map(|_| local_meta);
+                    (name.clone(), start.elapsed(), result)
+                })
+                .collect();
+
+        // 每个项目的耗时报告 + 作者信息合并
+        println!("\n{} 各项目同步耗时:", "[⏱️]".blue().bold());
+        for (name, elapsed, result) in sync_results {
+            match result {
+                Ok(local_meta) => {
+                    println!("  ⏱️  {}: {:.2?}", name.bright_white(), elapsed);
+                    if local_meta.version != meta.version {
+                        // worker 只在 should_update 通过时改版本，快照一致，直接采纳
+                        meta.version = local_meta.version;
+                        version_changed = true;
+                    }
+                    if local_meta.username != meta.username || local_meta.email != meta.email {
+                        meta.username = local_meta.username;
+                        meta.email = local_meta.email;
+                        author_changed = true;
+                    }
+                }
+                Err(e) => {
+                    println!("  ⚠️  {}: 同步失败: {}", name.yellow(), e.to_string().yellow());
+                }
+            }
+        }
+    }
+
+    // 唯一的一次 meta.toml 写入
+    if new_projects_count > 0 || path_updates > 0 || author_changed || version_changed {
+        core.update_meta_config(&meta)?;
+    }
+
+    if path_updates > 0 {
+        println!("    🔄 更新了 {} 个项目路径", path_updates);
+    }
+
     // 4. 显示同步结果
     println!("\n{} 同步结果:", "[📊]".blue().bold());
     println!("  🗑️  移除无效项目: {}", removed_projects.len().to_string().red().bold());
@@ -610,11 +835,12 @@ fn remove_duplicate_projects(core: &RmmCore) -> Result<Vec<String>> {
         }
     }
     
-    // 更新配置
+    // 去重结果以点更新批量写入日志，避免整文件重写
     if !removed_names.is_empty() {
-        core.update_meta_config(&meta)?;
+        let name_refs: Vec<&str> = removed_names.iter().map(|s| s.as_str()).collect();
+        core.remove_projects_from_meta(&name_refs)?;
     }
-    
+
     Ok(removed_names)
 }
 
@@ -679,34 +905,49 @@ fn generate_version_code(project_path: &Path) -> String {
     format!("{}01", date_str)
 }
 
+/// 批量解析所有项目的版本代码：一次仓库遍历 + 一次索引加载
+///
+/// 每个仓库只经由 GitSnapshot 打开一次拿 HEAD OID，索引命中的项目
+/// 直接返回记录值，未命中的才按日期规则现算（不写 module.prop）。
+/// 返回 项目名 -> (版本代码, 是否索引命中)。
+fn resolve_version_codes(
+    core: &RmmCore,
+    projects: &[(String, PathBuf)],
+) -> HashMap<String, (String, bool)> {
+    let mut resolved = HashMap::with_capacity(projects.len());
+
+    for (name, path) in projects {
+        let current = VersionInfo::from_module_prop(path).ok();
+        let head_oid = GitSnapshot::for_path(path).and_then(|snapshot| snapshot.head_oid);
+
+        let index_hit = match (&head_oid, &current) {
+            (Some(oid), Some(info)) => VersionCodeIndex::lookup(core, oid, path)
+                .map(|entry| entry.version == info.version && entry.version_code == info.version_code)
+                .unwrap_or(false),
+            _ => false,
+        };
+
+        let version_code = if index_hit {
+            current.as_ref().map(|info| info.version_code.clone()).unwrap_or_default()
+        } else {
+            generate_version_code(path)
+        };
+
+        resolved.insert(name.clone(), (version_code, index_hit));
+    }
+
+    resolved
+}
+
 /// 智能版本升级 - 修正版本格式，patch使用Git提交hash
 fn smart_version_bump(current_version: &str, project_path: &Path) -> String {
     // 移除可能的 'v' 前缀进行处理
     let version_without_v = current_version.trim_start_matches('v');
     
-    // 获取Git提交hash作为patch
-    let patch_hash = if let Ok(Some(git_info)) = GitAnalyzer::analyze_git_info(project_path) {
-        if let Ok(repo) = git2::Repository::open(&git_info.repo_root) {
-            if let Ok(head) = repo.head() {
-                if let Some(commit) = head.target() {
-                    let commit_str = commit.to_string();
-                    if commit_str.len() >= 8 {
-                        commit_str[..8].to_string() // 使用8位commit hash
-                    } else {
-                        "unknown".to_string()
-                    }
-                } else {
-                    "unknown".to_string()
-                }
-            } else {
-                "unknown".to_string()
-            }
-        } else {
-            "unknown".to_string()
-        }
-    } else {
-        "unknown".to_string()
-    };
+    // 获取Git提交hash作为patch（走本次运行的共享快照，不重复打开仓库）
+    let patch_hash = GitSnapshot::for_path(project_path)
+        .and_then(|snapshot| snapshot.head_short)
+        .unwrap_or_else(|| "unknown".to_string());
     
     // 检查当前版本是否已经包含patch部分
     if let Some(dash_pos) = version_without_v.find('-') {
@@ -782,9 +1023,12 @@ fn sync_update_json(project_path: &Path, version_info: &VersionInfo) -> Result<(
 }
 
 /// 同步全局版本到meta.toml - 🔧 修复：只有当项目版本更高时才同步
-fn sync_global_version(core: &RmmCore, project_version: &str) -> Result<()> {
-    let mut meta = core.get_meta_config()?;
-    
+/// 同步全局版本
+///
+/// 只修改传入的 meta 内存副本；write_meta 为 true 时才写 meta.toml。
+/// 并行阶段各 worker 持有 meta 快照副本，主线程合并后统一落盘，
+/// 避免多线程并发重写 meta.toml。
+fn sync_global_version(core: &RmmCore, project_version: &str, meta: &mut MetaConfig, write_meta: bool) -> Result<()> {
     // 移除版本号中的'v'前缀用于比较
     let clean_project_version = project_version.trim_start_matches('v').to_string();
     let clean_meta_version = meta.version.trim_start_matches('v');
@@ -814,7 +1058,9 @@ fn sync_global_version(core: &RmmCore, project_version: &str) -> Result<()> {
                  clean_project_version.bright_green());
         
         meta.version = clean_project_version;
-        core.update_meta_config(&meta)?;
+        if write_meta {
+            core.update_meta_config(meta)?;
+        }
     } else if meta.version != clean_project_version {
         println!("    ℹ️  保持全局版本: {} (项目版本: {})", 
                  meta.version.bright_green(), 
@@ -860,4 +1106,41 @@ mod tests {    use super::*;
         // 应该能够处理不存在的项目
         assert!(result.is_ok());
     }
+
+    #[test]
+    fn test_version_index_roundtrip() {
+        let temp_dir = TempDir::new().unwrap();
+        let index_path = temp_dir.path().join("version-code.index.json");
+
+        let mut index = VersionCodeIndex::default();
+        let key = VersionCodeIndex::key("abc123def456", Path::new("/tmp/demo_project"));
+        index.entries.insert(
+            key.clone(),
+            VersionIndexEntry {
+                version: "v1.2.3-abc123de".to_string(),
+                version_code: "2026082701".to_string(),
+            },
+        );
+        index.save_to(&index_path).unwrap();
+
+        // 读回后条目一致；HEAD 变化产生不同的键，不会误命中
+        let loaded = VersionCodeIndex::load_from(&index_path);
+        assert_eq!(loaded.entries.get(&key), index.entries.get(&key));
+        let other_key = VersionCodeIndex::key("ffff0000eeee", Path::new("/tmp/demo_project"));
+        assert!(loaded.entries.get(&other_key).is_none());
+    }
+
+    #[test]
+    fn test_version_index_load_missing_or_corrupt() {
+        let temp_dir = TempDir::new().unwrap();
+        // 文件不存在 → 空索引
+        let missing = VersionCodeIndex::load_from(&temp_dir.path().join("no-such.json"));
+        assert!(missing.entries.is_empty());
+
+        // 文件损坏 → 空索引而不是报错
+        let corrupt_path = temp_dir.path().join("corrupt.json");
+        fs::write(&corrupt_path, "{not valid json").unwrap();
+        let corrupt = VersionCodeIndex::load_from(&corrupt_path);
+        assert!(corrupt.entries.is_empty());
+    }
 }
@@ -3,11 +3,13 @@ use pyo3::prelude::*;
 use pyo3::types::{PyDict, PyList, PyString, PyModule};
 use std::collections::HashMap;
 use std::path::Path;
+use std::sync::Arc;
 
 /// Python 包装器 - RmmCore
 #[pyclass(name = "RmmCore")]
 pub struct PyRmmCore {
-    inner: RmmCore,
+    // Arc 共享：异步方法把耗时任务挪到 tokio 工作线程时需要持有同一个核心实例
+    inner: Arc<RmmCore>,
 }
 
 #[pymethods]
@@ -15,7 +17,7 @@ impl PyRmmCore {
     #[new]
     fn new() -> Self {
         Self {
-            inner: RmmCore::new(),
+            inner: Arc::new(RmmCore::new()),
         }
     }
 
@@ -26,7 +28,8 @@ impl PyRmmCore {
 
     /// 获取 meta 配置
     fn get_meta_config(&self, py: Python) -> PyResult<PyObject> {
-        match self.inner.get_meta_config() {
+        // 文件 I/O 和 TOML 解析在 GIL 之外执行
+        match py.allow_threads(|| self.inner.get_meta_config()) {
             Ok(meta) => {
                 let dict = PyDict::new(py);
                 dict.set_item("email", meta.email)?;
@@ -50,6 +53,7 @@ impl PyRmmCore {
     /// 更新 meta 配置
     fn update_meta_config(
         &self,
+        py: Python,
         email: String,
         username: String,
         version: String,
@@ -61,15 +65,15 @@ impl PyRmmCore {
             version,
             projects,
         };
-        
-        self.inner.update_meta_config(&meta).map_err(|e| {
+
+        py.allow_threads(|| self.inner.update_meta_config(&meta)).map_err(|e| {
             PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string())
         })
     }
 
     /// 根据项目名获取路径
-    fn get_project_path(&self, project_name: &str) -> PyResult<Option<String>> {
-        match self.inner.get_project_path(project_name) {
+    fn get_project_path(&self, py: Python, project_name: &str) -> PyResult<Option<String>> {
+        match py.allow_threads(|| self.inner.get_project_path(project_name)) {
             Ok(Some(path)) => Ok(Some(path.to_string_lossy().to_string())),
             Ok(None) => Ok(None),
             Err(e) => Err(PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(
@@ -80,7 +84,7 @@ impl PyRmmCore {
 
     /// 检查项目有效性
     fn check_projects_validity(&self, py: Python) -> PyResult<PyObject> {
-        match self.inner.check_projects_validity() {
+        match py.allow_threads(|| self.inner.check_projects_validity()) {
             Ok(validity) => {
                 let dict = PyDict::new(py);
                 for (name, is_valid) in validity {
@@ -95,14 +99,20 @@ impl PyRmmCore {
     }
 
     /// 扫描项目 - 简化版本
+    /// max_parallelism 控制扫描线程数（None = 逻辑核心数）
     fn scan_projects(
         &self,
         py: Python,
         scan_path: String,
         max_depth: Option<usize>,
+        max_parallelism: Option<usize>,
     ) -> PyResult<PyObject> {
-        let path = Path::new(&scan_path);
-        match self.inner.scan_projects(path, max_depth) {            
+        // 扫描期间释放 GIL，让其他 Python 线程继续执行
+        let scan_result = py.allow_threads(|| {
+            let path = Path::new(&scan_path);
+            self.inner.scan_projects_with_parallelism(path, max_depth, max_parallelism)
+        });
+        match scan_result {
             Ok(results) => {
                 let list = PyList::empty(py);
                 for result in results {
@@ -120,22 +130,135 @@ impl PyRmmCore {
         }
     }
 
+    /// 扫描项目 - 懒转换版本
+    ///
+    /// 返回 ProjectScanResult 包装对象列表，字段在属性访问时才转换，
+    /// 大结果集不用预先支付整表字典转换的开销。
+    fn scan_projects_lazy(
+        &self,
+        py: Python,
+        scan_path: String,
+        max_depth: Option<usize>,
+        max_parallelism: Option<usize>,
+    ) -> PyResult<Vec<PyProjectScanResult>> {
+        let scan_result = py.allow_threads(|| {
+            let path = Path::new(&scan_path);
+            self.inner.scan_projects_with_parallelism(path, max_depth, max_parallelism)
+        });
+        match scan_result {
+            Ok(results) => Ok(results
+                .into_iter()
+                .map(|inner| PyProjectScanResult { inner })
+                .collect()),
+            Err(e) => Err(PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(
+                e.to_string(),
+            )),
+        }
+    }
+
     /// 同步项目
     fn sync_projects(
         &self,
+        py: Python,
         scan_paths: Vec<String>,
         max_depth: Option<usize>,
     ) -> PyResult<()> {
-        let paths: Vec<&Path> = scan_paths.iter().map(|p| Path::new(p)).collect();
-        self.inner.sync_projects(&paths, max_depth).map_err(|e| {
+        py.allow_threads(|| {
+            let paths: Vec<&Path> = scan_paths.iter().map(|p| Path::new(p)).collect();
+            self.inner.sync_projects(&paths, max_depth)
+        })
+        .map_err(|e| {
             PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string())
         })
     }
 
+    /// 扫描项目 - 异步版本
+    ///
+    /// 返回 awaitable，重活在 tokio 阻塞线程池上执行，事件循环不会被占住；
+    /// 结果与 scan_projects_lazy 一致（ProjectScanResult 包装对象列表）
+    fn scan_projects_async<'py>(
+        &self,
+        py: Python<'py>,
+        scan_path: String,
+        max_depth: Option<usize>,
+        max_parallelism: Option<usize>,
+    ) -> PyResult<Bound<'py, PyAny>> {
+        let core = Arc::clone(&self.inner);
+        pyo3_async_runtimes::tokio::future_into_py(py, async move {
+            let results = tokio::task::spawn_blocking(move || {
+                core.scan_projects_with_parallelism(Path::new(&scan_path), max_depth, max_parallelism)
+            })
+            .await
+            .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(format!("后台扫描任务失败: {}", e)))?
+            .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string()))?;
+            Ok(results
+                .into_iter()
+                .map(|inner| PyProjectScanResult { inner })
+                .collect::<Vec<_>>())
+        })
+    }
+
+    /// 同步项目 - 异步版本
+    fn sync_projects_async<'py>(
+        &self,
+        py: Python<'py>,
+        scan_paths: Vec<String>,
+        max_depth: Option<usize>,
+    ) -> PyResult<Bound<'py, PyAny>> {
+        let core = Arc::clone(&self.inner);
+        pyo3_async_runtimes::tokio::future_into_py(py, async move {
+            tokio::task::spawn_blocking(move || {
+                let paths: Vec<&Path> = scan_paths.iter().map(|p| Path::new(p)).collect();
+                core.sync_projects(&paths, max_depth)
+            })
+            .await
+            .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(format!("后台同步任务失败: {}", e)))?
+            .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string()))
+        })
+    }
+
+    /// 检查项目有效性 - 异步版本
+    fn check_projects_validity_async<'py>(&self, py: Python<'py>) -> PyResult<Bound<'py, PyAny>> {
+        let core = Arc::clone(&self.inner);
+        pyo3_async_runtimes::tokio::future_into_py(py, async move {
+            tokio::task::spawn_blocking(move || core.check_projects_validity())
+                .await
+                .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(format!("后台检查任务失败: {}", e)))?
+                .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string()))
+        })
+    }
+
+    /// 获取 Git 信息 - 异步版本
+    fn get_git_info_async<'py>(&self, py: Python<'py>, project_path: String) -> PyResult<Bound<'py, PyAny>> {
+        let core = Arc::clone(&self.inner);
+        pyo3_async_runtimes::tokio::future_into_py(py, async move {
+            let git_info = tokio::task::spawn_blocking(move || {
+                core.get_git_info(Path::new(&project_path))
+            })
+            .await
+            .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(format!("后台 Git 任务失败: {}", e)))?
+            .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string()))?;
+            Python::with_gil(|py| -> PyResult<PyObject> {
+                let dict = PyDict::new(py);
+                dict.set_item("repo_root", git_info.repo_root.to_string_lossy().to_string())?;
+                dict.set_item("relative_path", git_info.relative_path.to_string_lossy().to_string())?;
+                dict.set_item("branch", git_info.branch)?;
+                dict.set_item("remote_url", git_info.remote_url)?;
+                dict.set_item("has_uncommitted_changes", git_info.has_uncommitted_changes)?;
+                dict.set_item("last_commit_hash", git_info.last_commit_hash)?;
+                dict.set_item("last_commit_message", git_info.last_commit_message)?;
+                Ok(dict.into())
+            })
+        })
+    }
+
     /// 获取项目配置
     fn get_project_config(&self, py: Python, project_path: String) -> PyResult<PyObject> {
-        let path = Path::new(&project_path);
-        match self.inner.get_project_config(path) {
+        let config_result = py.allow_threads(|| {
+            let path = Path::new(&project_path);
+            self.inner.get_project_config(path)
+        });
+        match config_result {
             Ok(project) => {
                 let dict = PyDict::new(py);
                 
@@ -162,8 +285,11 @@ impl PyRmmCore {
 
     /// 获取 module.prop
     fn get_module_prop(&self, py: Python, project_path: String) -> PyResult<PyObject> {
-        let path = Path::new(&project_path);
-        match self.inner.get_module_prop(path) {
+        let prop_result = py.allow_threads(|| {
+            let path = Path::new(&project_path);
+            self.inner.get_module_prop(path)
+        });
+        match prop_result {
             Ok(prop) => {
                 let dict = PyDict::new(py);
                 dict.set_item("id", prop.id)?;
@@ -184,6 +310,7 @@ impl PyRmmCore {
     /// 更新 module.prop
     fn update_module_prop(
         &self,
+        py: Python,
         project_path: String,
         id: String,
         name: String,
@@ -193,7 +320,6 @@ impl PyRmmCore {
         description: String,
         update_json: String,
     ) -> PyResult<()> {
-        let path = Path::new(&project_path);
         let prop = ModuleProp {
             id,
             name,
@@ -203,16 +329,23 @@ impl PyRmmCore {
             description,
             update_json,
         };
-        
-        self.inner.update_module_prop(path, &prop).map_err(|e| {
+
+        py.allow_threads(|| {
+            let path = Path::new(&project_path);
+            self.inner.update_module_prop(path, &prop)
+        })
+        .map_err(|e| {
             PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string())
         })
     }
 
     /// 获取 Git 信息
     fn get_git_info(&self, py: Python, project_path: String) -> PyResult<PyObject> {
-        let path = Path::new(&project_path);
-        match self.inner.get_git_info(path) {
+        let git_result = py.allow_threads(|| {
+            let path = Path::new(&project_path);
+            self.inner.get_git_info(path)
+        });
+        match git_result {
             Ok(git_info) => {
                 let dict = PyDict::new(py);
                 dict.set_item("repo_root", git_info.repo_root.to_string_lossy().to_string())?;
@@ -231,14 +364,17 @@ impl PyRmmCore {
     }
 
     /// 移除项目
-    fn remove_project_from_meta(&self, project_name: String) -> PyResult<bool> {
-        self.inner.remove_project_from_meta(&project_name).map_err(|e| {
+    fn remove_project_from_meta(&self, py: Python, project_name: String) -> PyResult<bool> {
+        py.allow_threads(|| self.inner.remove_project_from_meta(&project_name)).map_err(|e| {
             PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string())
         })
     }    /// 移除多个项目
     fn remove_projects_from_meta(&self, py: Python, project_names: Vec<String>) -> PyResult<PyObject> {
-        let names: Vec<&str> = project_names.iter().map(|s| s.as_str()).collect();
-        match self.inner.remove_projects_from_meta(&names) {
+        let removed_result = py.allow_threads(|| {
+            let names: Vec<&str> = project_names.iter().map(|s| s.as_str()).collect();
+            self.inner.remove_projects_from_meta(&names)
+        });
+        match removed_result {
             Ok(removed) => {
                 let json_str = serde_json::to_string(&removed).unwrap_or_else(|_| "[]".to_string());
                 Ok(PyString::new(py, &json_str).into())
@@ -249,7 +385,7 @@ impl PyRmmCore {
         }
     }    /// 移除无效项目
     fn remove_invalid_projects(&self, py: Python) -> PyResult<PyObject> {
-        match self.inner.remove_invalid_projects() {
+        match py.allow_threads(|| self.inner.remove_invalid_projects()) {
             Ok(removed) => {
                 let json_str = serde_json::to_string(&removed).unwrap_or_else(|_| "[]".to_string());
                 Ok(PyString::new(py, &json_str).into())
@@ -266,6 +402,15 @@ impl PyRmmCore {
         let dict = PyDict::new(py);
         dict.set_item("meta_cached", meta_cached)?;
         dict.set_item("project_count", project_count)?;
+        // 各缓存的锁竞争计数（慢路径命中次数）
+        let contention = self.inner.get_cache_contention();
+        let contention_dict = PyDict::new(py);
+        for (name, count) in contention {
+            contention_dict.set_item(name, count)?;
+        }
+        dict.set_item("lock_contention", contention_dict)?;
+        // 完整观测指标：命中/未命中/过期、加载延迟直方图、近似字节数
+        dict.set_item("metrics", json_value_to_py(py, &self.inner.get_cache_metrics())?)?;
         Ok(dict.into())
     }
 
@@ -382,6 +527,8 @@ impl PyRmmCore {
                     exclude: Vec::new(),
                 }),
                 scripts: Some(HashMap::new()),
+                compression: None,
+                source_format: None,
             },
         };
         
@@ -416,8 +563,11 @@ impl PyRmmCore {
 
     /// 获取 rmake 配置
     fn get_rmake_config(&self, py: Python, project_path: String) -> PyResult<PyObject> {
-        let path = Path::new(&project_path);
-        match self.inner.get_rmake_config(path) {
+        let config_result = py.allow_threads(|| {
+            let path = Path::new(&project_path);
+            self.inner.get_rmake_config(path)
+        });
+        match config_result {
             Ok(config) => {
                 let dict = PyDict::new(py);
                 
@@ -479,14 +629,15 @@ impl PyRmmCore {
             projects,
         };
         
-        self.inner.update_meta_config(&meta).map_err(|e| {
+        let py = config_dict.py();
+        py.allow_threads(|| self.inner.update_meta_config(&meta)).map_err(|e| {
             PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string())
         })
     }
 
     /// 获取 meta 配置中的特定值
     fn get_meta_value(&self, py: Python, key: String) -> PyResult<PyObject> {
-        match self.inner.get_meta_config() {
+        match py.allow_threads(|| self.inner.get_meta_config()) {
             Ok(meta) => {
                 match key.as_str() {
                     "email" => Ok(PyString::new(py, &meta.email).into()),
@@ -506,4 +657,94 @@ impl PyRmmCore {
         }
     }}
 
+/// Python 包装器 - 懒转换的项目扫描结果
+///
+/// 字段保存在 Rust 侧，属性访问时才转换为 Python 对象，
+/// 大结果集只为实际读取的字段付出转换成本。
+#[pyclass(name = "ProjectScanResult")]
+pub struct PyProjectScanResult {
+    inner: ProjectScanResult,
+}
+
+#[pymethods]
+impl PyProjectScanResult {
+    /// 项目名称
+    #[getter]
+    fn name(&self) -> &str {
+        &self.inner.name
+    }
+
+    /// 项目路径
+    #[getter]
+    fn path(&self) -> String {
+        self.inner.path.to_string_lossy().to_string()
+    }
+
+    /// 项目是否有效
+    #[getter]
+    fn is_valid(&self) -> bool {
+        self.inner.is_valid
+    }
+
+    /// Git 信息（按需转换，无仓库时返回 None）
+    #[getter]
+    fn git_info(&self, py: Python) -> PyResult<PyObject> {
+        match &self.inner.git_info {
+            Some(git_info) => {
+                let dict = PyDict::new(py);
+                dict.set_item("repo_root", git_info.repo_root.to_string_lossy().to_string())?;
+                dict.set_item("relative_path", git_info.relative_path.to_string_lossy().to_string())?;
+                dict.set_item("branch", git_info.branch.clone())?;
+                dict.set_item("remote_url", git_info.remote_url.clone())?;
+                dict.set_item("has_uncommitted_changes", git_info.has_uncommitted_changes)?;
+                dict.set_item("last_commit_hash", git_info.last_commit_hash.clone())?;
+                dict.set_item("last_commit_message", git_info.last_commit_message.clone())?;
+                Ok(dict.into())
+            }
+            None => Ok(py.None()),
+        }
+    }
+
+    fn __repr__(&self) -> String {
+        format!(
+            "ProjectScanResult(name='{}', path='{}', is_valid={})",
+            self.inner.name,
+            self.inner.path.display(),
+            self.inner.is_valid
+        )
+    }
+}
+
 
+
+/// 将 serde_json::Value 递归转换为 Python 对象（dict/list/标量）
+fn json_value_to_py(py: Python, value: &serde_json::Value) -> PyResult<PyObject> {
+    match value {
+        serde_json::Value::Null => Ok(py.None()),
+        serde_json::Value::Bool(b) => Ok(b.into_pyobject(py)?.to_owned().into_any().unbind()),
+        serde_json::Value::Number(n) => {
+            if let Some(i) = n.as_i64() {
+                Ok(i.into_pyobject(py)?.into_any().unbind())
+            } else if let Some(u) = n.as_u64() {
+                Ok(u.into_pyobject(py)?.into_any().unbind())
+            } else {
+                Ok(n.as_f64().unwrap_or(0.0).into_pyobject(py)?.into_any().unbind())
+            }
+        }
+        serde_json::Value::String(s) => Ok(PyString::new(py, s).into()),
+        serde_json::Value::Array(items) => {
+            let list = PyList::empty(py);
+            for item in items {
+                list.append(json_value_to_py(py, item)?)?;
+            }
+            Ok(list.into())
+        }
+        serde_json::Value::Object(map) => {
+            let dict = PyDict::new(py);
+            for (key, item) in map {
+                dict.set_item(key, json_value_to_py(py, item)?)?;
+            }
+            Ok(dict.into())
+        }
+    }
+}
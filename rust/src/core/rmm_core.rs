@@ -42,6 +42,15 @@ pub struct MetaConfig {
     pub projects: HashMap<String, String>,
 }
 
+/// meta 点更新日志条目：追加写入 meta.journal.jsonl，每行一个操作。
+/// meta.toml 保持为导出视图，读取时按顺序回放日志得到最新状态
+#[derive(Debug, Clone, Serialize, Deserialize)]
+#[serde(tag = "op", rename_all = "snake_case")]
+enum MetaJournalOp {
+    SetProject { name: String, path: String },
+    RemoveProject { name: String },
+}
+
 /// RmmProject.toml 文件结构
 #[derive(Debug, Clone, Serialize, Deserialize, Default)]
 pub struct RmmProject {
@@ -112,6 +121,12 @@ pub struct BuildConfig {
     pub postbuild: Vec<String>,
     pub src: Option<SrcConfig>,
     pub scripts: Option<HashMap<String, String>>,
+    /// 压缩配置文件：store（仅存储）、fast（快速）、balanced（默认）、max（最高压缩）
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub compression: Option<String>,
+    /// 源码包格式：tar.gz（默认，并行 gzip）或 tar.zst（多线程 zstd）
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub source_format: Option<String>,
 }
 
 #[derive(Debug, Clone, Serialize, Deserialize, Default)]
@@ -141,6 +156,19 @@ pub struct GitInfo {
     pub last_commit_message: Option<String>,
 }
 
+/// Git 状态缓存条目：HEAD OID 或 index mtime 变化时失效，另设 TTL 兜底
+///
+/// 只改工作区文件（不 add 不 commit）时 HEAD 和 index 都不会变，
+/// 长驻进程（如 MCP 服务持有的 RmmCore）若只看这两个信号会永远
+/// 拿到陈旧的脏状态，因此条目超过 TTL 后强制重新遍历。
+#[derive(Debug, Clone)]
+struct StatusCacheEntry {
+    head_oid: Option<String>,
+    index_mtime_ns: Option<u128>,
+    has_changes: bool,
+    computed_at: Instant,
+}
+
 /// Git 分析器
 pub struct GitAnalyzer;
 
@@ -159,7 +187,8 @@ impl GitAnalyzer {
             
             let branch = Self::get_current_branch(&repo)?;
             let remote_url = Self::get_remote_url(&repo)?;
-            let has_uncommitted_changes = Self::has_uncommitted_changes(&repo)?;
+            let has_uncommitted_changes =
+                Self::has_uncommitted_changes_incremental(&repo, &repo_root, &relative_path)?;
             let (last_commit_hash, last_commit_message) = Self::get_last_commit_info(&repo)?;
             
             Ok(Some(GitInfo {
@@ -225,16 +254,63 @@ impl GitAnalyzer {
         Ok(None)
     }
     
-    /// 检查是否有未提交的更改
-    fn has_uncommitted_changes(repo: &Repository) -> Result<bool> {
+    /// 状态缓存条目的最长存活时间（与 RmmCore 的 git_cache TTL 一致）
+    const STATUS_CACHE_TTL: Duration = Duration::from_secs(60);
+
+    /// 进程级状态缓存：按 (仓库根目录, pathspec) 缓存，以 HEAD OID + index mtime 校验
+    fn status_cache() -> &'static Mutex<HashMap<(PathBuf, PathBuf), StatusCacheEntry>> {
+        static CACHE: std::sync::OnceLock<Mutex<HashMap<(PathBuf, PathBuf), StatusCacheEntry>>> =
+            std::sync::OnceLock::new();
+        CACHE.get_or_init(|| Mutex::new(HashMap::new()))
+    }
+
+    /// 增量检查未提交的更改
+    ///
+    /// 项目位于 monorepo 子目录时，状态遍历通过 pathspec 限定到该子目录；
+    /// 结果按 HEAD OID 和 .git/index 的 mtime 缓存，两者未变时直接复用，
+    /// 同一次进程内对同一项目的重复查询不再触发全仓库状态遍历。
+    fn has_uncommitted_changes_incremental(
+        repo: &Repository,
+        repo_root: &Path,
+        relative_path: &Path,
+    ) -> Result<bool> {
+        let head_oid = repo.head().ok().and_then(|h| h.target()).map(|oid| oid.to_string());
+        let index_mtime_ns = fs::metadata(repo_root.join(".git").join("index"))
+            .ok()
+            .and_then(|m| m.modified().ok())
+            .and_then(|t| t.duration_since(std::time::UNIX_EPOCH).ok())
+            .map(|d| d.as_nanos());
+
+        let key = (repo_root.to_path_buf(), relative_path.to_path_buf());
+        {
+            let cache = Self::status_cache().lock().unwrap();
+            if let Some(entry) = cache.get(&key) {
+                if entry.head_oid == head_oid
+                    && entry.index_mtime_ns == index_mtime_ns
+                    && entry.computed_at.elapsed() < Self::STATUS_CACHE_TTL
+                {
+                    return Ok(entry.has_changes);
+                }
+            }
+        }
+
         let mut opts = StatusOptions::new();
         opts.include_ignored(false);
         opts.include_untracked(true);
-        
+        if !relative_path.as_os_str().is_empty() {
+            opts.pathspec(relative_path.to_string_lossy().as_ref());
+        }
+
         let statuses = repo.statuses(Some(&mut opts))
             .with_context(|| "Failed to get repository status")?;
-        
-        Ok(!statuses.is_empty())
+        let has_changes = !statuses.is_empty();
+
+        Self::status_cache().lock().unwrap().insert(
+            key,
+            StatusCacheEntry { head_oid, index_mtime_ns, has_changes, computed_at: Instant::now() },
+        );
+
+        Ok(has_changes)
     }
     
     /// 获取最后一次提交信息
@@ -256,27 +332,179 @@ impl GitAnalyzer {
     }
 }
 
+/// 持久化缓存条目：记录源文件的 mtime（纳秒）和大小用于校验
+#[derive(Debug, Clone, Serialize, Deserialize)]
+struct PersistentEntry<T> {
+    mtime_ns: u128,
+    size: u64,
+    data: T,
+}
+
+/// 跨进程持久化的配置缓存，序列化到 RMM_ROOT/.cache/config-cache.json
+/// CLI 每次调用都是新进程，内存缓存无法复用；这个缓存让热路径跳过 TOML 解析
+#[derive(Debug, Clone, Serialize, Deserialize, Default)]
+struct PersistentConfigCache {
+    meta: Option<PersistentEntry<MetaConfig>>,
+    projects: HashMap<String, PersistentEntry<RmmProject>>,
+    module_props: HashMap<String, PersistentEntry<ModuleProp>>,
+}
+
+/// 缓存锁竞争计数器：读路径碰上写锁或被占用的分片时递增，
+/// 通过 get_cache_contention 暴露，用于验证分片缓存消除了读竞争
+#[derive(Debug, Default)]
+struct CacheContention {
+    meta: std::sync::atomic::AtomicU64,
+    project: std::sync::atomic::AtomicU64,
+    git: std::sync::atomic::AtomicU64,
+}
+
+/// 单个缓存的命中/加载指标：全部为 Relaxed 原子计数，读路径零额外开销
+#[derive(Debug, Default)]
+struct CacheCounters {
+    hits: std::sync::atomic::AtomicU64,
+    misses: std::sync::atomic::AtomicU64,
+    expired: std::sync::atomic::AtomicU64,
+    load_ns_total: std::sync::atomic::AtomicU64,
+    load_count: std::sync::atomic::AtomicU64,
+    load_max_ns: std::sync::atomic::AtomicU64,
+    /// 加载延迟直方图：<1ms / <10ms / <100ms / >=100ms
+    load_buckets: [std::sync::atomic::AtomicU64; 4],
+}
+
+impl CacheCounters {
+    fn record_load(&self, elapsed: Duration) {
+        use std::sync::atomic::Ordering::Relaxed;
+        let ns = elapsed.as_nanos() as u64;
+        self.load_ns_total.fetch_add(ns, Relaxed);
+        self.load_count.fetch_add(1, Relaxed);
+        self.load_max_ns.fetch_max(ns, Relaxed);
+        let bucket = match ns {
+            n if n < 1_000_000 => 0,
+            n if n < 10_000_000 => 1,
+            n if n < 100_000_000 => 2,
+            _ => 3,
+        };
+        self.load_buckets[bucket].fetch_add(1, Relaxed);
+    }
+
+    fn to_json(&self) -> serde_json::Value {
+        use std::sync::atomic::Ordering::Relaxed;
+        let load_count = self.load_count.load(Relaxed);
+        let load_avg_ms = if load_count > 0 {
+            self.load_ns_total.load(Relaxed) as f64 / load_count as f64 / 1_000_000.0
+        } else {
+            0.0
+        };
+        serde_json::json!({
+            "hits": self.hits.load(Relaxed),
+            "misses": self.misses.load(Relaxed),
+            "expired": self.expired.load(Relaxed),
+            "load_count": load_count,
+            "load_avg_ms": load_avg_ms,
+            "load_max_ms": self.load_max_ns.load(Relaxed) as f64 / 1_000_000.0,
+            "load_histogram": {
+                "lt_1ms": self.load_buckets[0].load(Relaxed),
+                "lt_10ms": self.load_buckets[1].load(Relaxed),
+                "lt_100ms": self.load_buckets[2].load(Relaxed),
+                "ge_100ms": self.load_buckets[3].load(Relaxed),
+            },
+        })
+    }
+}
+
+/// 三个缓存各自的指标集合
+#[derive(Debug, Default)]
+struct CacheMetrics {
+    meta: CacheCounters,
+    project: CacheCounters,
+    git: CacheCounters,
+}
+
 /// RmmCore 主要结构体
 #[derive(Debug)]
 pub struct RmmCore {
     rmm_root: PathBuf,
-    meta_cache: Arc<Mutex<Option<CacheItem<MetaConfig>>>>,
-    project_cache: Arc<Mutex<HashMap<String, CacheItem<RmmProject>>>>,
+    /// meta 是单条目，用读写锁让并发读者互不阻塞
+    meta_cache: Arc<std::sync::RwLock<Option<CacheItem<MetaConfig>>>>,
+    /// 项目配置缓存：分片读写结构，并发读 get_project_config 零竞争
+    project_cache: Arc<dashmap::DashMap<String, CacheItem<RmmProject>>>,
     cache_ttl: Duration,
-    /// Git 信息缓存
-    git_cache: Arc<Mutex<HashMap<PathBuf, (GitInfo, Instant)>>>,
-
+    /// Git 信息缓存（分片读写结构）
+    git_cache: Arc<dashmap::DashMap<PathBuf, (GitInfo, Instant)>>,
+    /// 锁竞争计数
+    contention: CacheContention,
+    /// 命中/加载延迟指标
+    metrics: CacheMetrics,
+    /// 持久化配置缓存（首次访问时按需加载，Drop 时落盘）
+    persistent_cache: std::sync::OnceLock<Arc<Mutex<PersistentConfigCache>>>,
+    persistent_dirty: std::sync::atomic::AtomicBool,
 }
 
 impl RmmCore {    /// 创建新的 RmmCore 实例
     pub fn new() -> Self {
+        let rmm_root = Self::get_rmm_root_path();
         Self {
-            rmm_root: Self::get_rmm_root_path(),
-            meta_cache: Arc::new(Mutex::new(None)),
-            project_cache: Arc::new(Mutex::new(HashMap::new())),
+            rmm_root,
+            meta_cache: Arc::new(std::sync::RwLock::new(None)),
+            project_cache: Arc::new(dashmap::DashMap::new()),
             cache_ttl: Duration::from_secs(60), // 60秒缓存
-            git_cache: Arc::new(Mutex::new(HashMap::new())),
+            git_cache: Arc::new(dashmap::DashMap::new()),
+            contention: CacheContention::default(),
+            metrics: CacheMetrics::default(),
+            persistent_cache: std::sync::OnceLock::new(),
+            persistent_dirty: std::sync::atomic::AtomicBool::new(false),
+        }
+    }
+
+    /// 按需加载持久化缓存：不触碰配置的调用（如 rmm version）零磁盘读取
+    fn persistent_cache(&self) -> &Arc<Mutex<PersistentConfigCache>> {
+        self.persistent_cache
+            .get_or_init(|| Arc::new(Mutex::new(Self::load_persistent_cache(&self.rmm_root))))
+    }
+
+    /// 持久化缓存文件路径
+    fn persistent_cache_path(rmm_root: &Path) -> PathBuf {
+        rmm_root.join(".cache").join("config-cache.json")
+    }
+
+    /// 启动时加载持久化缓存（文件缺失或损坏时静默回退为空缓存）
+    fn load_persistent_cache(rmm_root: &Path) -> PersistentConfigCache {
+        let path = Self::persistent_cache_path(rmm_root);
+        fs::read_to_string(&path)
+            .ok()
+            .and_then(|content| serde_json::from_str(&content).ok())
+            .unwrap_or_default()
+    }
+
+    /// 读取文件的 mtime（纳秒）和大小，作为持久化缓存的校验键
+    fn file_stamp(path: &Path) -> Option<(u128, u64)> {
+        let metadata = fs::metadata(path).ok()?;
+        let mtime = metadata.modified().ok()?;
+        let nanos = mtime.duration_since(std::time::UNIX_EPOCH).ok()?.as_nanos();
+        Some((nanos, metadata.len()))
+    }
+
+    /// 将持久化缓存落盘（仅在有更新时写入）
+    pub fn flush_persistent_cache(&self) {
+        use std::sync::atomic::Ordering;
+        if !self.persistent_dirty.swap(false, Ordering::SeqCst) {
+            return;
+        }
+        let path = Self::persistent_cache_path(&self.rmm_root);
+        if let Some(parent) = path.parent() {
+            if fs::create_dir_all(parent).is_err() {
+                return;
+            }
         }
+        let cache = self.persistent_cache().lock().unwrap();
+        if let Ok(content) = serde_json::to_string(&*cache) {
+            let _ = fs::write(&path, content);
+        }
+    }
+
+    /// 标记持久化缓存已更新
+    fn mark_persistent_dirty(&self) {
+        self.persistent_dirty.store(true, std::sync::atomic::Ordering::SeqCst);
     }
 
     /// 功能一：获取 RMM_ROOT 路径
@@ -304,33 +532,78 @@ impl RmmCore {    /// 创建新的 RmmCore 实例
         self.rmm_root.join("meta.toml")
     }    /// 功能二：获取 RMM_ROOT/meta.toml 文件的内容（解析为字典）
     pub fn get_meta_config(&self) -> Result<MetaConfig> {
-        // 检查缓存
+        // 检查缓存（读锁；拿不到说明有写者，计一次竞争）
         {
-            let cache = self.meta_cache.lock().unwrap();
+            let cache = match self.meta_cache.try_read() {
+                Ok(guard) => guard,
+                Err(std::sync::TryLockError::WouldBlock) => {
+                    self.contention.meta.fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+                    self.meta_cache.read().unwrap()
+                }
+                Err(std::sync::TryLockError::Poisoned(e)) => e.into_inner(),
+            };
             if let Some(cached) = cache.as_ref() {
                 if !cached.is_expired() {
+                    self.metrics.meta.hits.fetch_add(1, std::sync::atomic::Ordering::Relaxed);
                     return Ok(cached.data.clone());
                 }
+                self.metrics.meta.expired.fetch_add(1, std::sync::atomic::Ordering::Relaxed);
             }
         }
+        self.metrics.meta.misses.fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+        let load_start = Instant::now();
 
-        // 读取并解析文件
         let meta_path = self.get_meta_path();
+
+        // 检查持久化缓存：mtime/大小未变时直接复用，跳过 TOML 解析
+        if let Some(stamp) = Self::file_stamp(&meta_path) {
+            let cache = self.persistent_cache().lock().unwrap();
+            if let Some(entry) = cache.meta.as_ref() {
+                if (entry.mtime_ns, entry.size) == stamp {
+                    let mut meta = entry.data.clone();
+                    drop(cache);
+                    // 持久化缓存只对应 meta.toml 本体，日志里的点更新要补回放
+                    self.replay_meta_journal(&mut meta);
+                    let mut mem_cache = self.meta_cache.write().unwrap();
+                    *mem_cache = Some(CacheItem::new(meta.clone(), self.cache_ttl));
+                    self.metrics.meta.record_load(load_start.elapsed());
+                    return Ok(meta);
+                }
+            }
+        }
+
+        // 读取并解析文件
         let content = fs::read_to_string(&meta_path)
             .with_context(|| format!("Failed to read meta.toml from {}", meta_path.display()))?;
-        
-        let meta: MetaConfig = toml::from_str(&content)
+
+        let mut meta: MetaConfig = toml::from_str(&content)
             .with_context(|| "Failed to parse meta.toml")?;
 
+        // 持久化缓存记录文件本体状态（按 meta.toml 的 stamp 失效）
+        self.persist_meta(&meta_path, &meta);
+
+        // 回放日志得到最新状态
+        self.replay_meta_journal(&mut meta);
+
         // 更新缓存
         {
-            let mut cache = self.meta_cache.lock().unwrap();
+            let mut cache = self.meta_cache.write().unwrap();
             *cache = Some(CacheItem::new(meta.clone(), self.cache_ttl));
         }
+        self.metrics.meta.record_load(load_start.elapsed());
 
         Ok(meta)
     }
 
+    /// 将 meta 配置写入持久化缓存
+    fn persist_meta(&self, meta_path: &Path, meta: &MetaConfig) {
+        if let Some((mtime_ns, size)) = Self::file_stamp(meta_path) {
+            let mut cache = self.persistent_cache().lock().unwrap();
+            cache.meta = Some(PersistentEntry { mtime_ns, size, data: meta.clone() });
+            self.mark_persistent_dirty();
+        }
+    }
+
     /// 功能三：更新 meta.toml 文件的内容
     pub fn update_meta_config(&self, meta: &MetaConfig) -> Result<()> {
         let meta_path = self.get_meta_path();
@@ -342,27 +615,121 @@ impl RmmCore {    /// 创建新的 RmmCore 实例
         }
 
         let content = toml::to_string_pretty(meta)
-            .with_context(|| "Failed to serialize meta config")?;
+            .with_context(|| "Failed to serialize meta.toml")?;
             fs::write(&meta_path, content)
             .with_context(|| format!("Failed to write meta.toml to {}", meta_path.display()))?;
 
+        // 全量写出即是一次压缩：meta.toml 已包含最新状态，日志可以清空
+        let _ = fs::remove_file(self.get_meta_journal_path());
+
         // 更新缓存
         {
-            let mut cache = self.meta_cache.lock().unwrap();
+            let mut cache = self.meta_cache.write().unwrap();
             *cache = Some(CacheItem::new(meta.clone(), self.cache_ttl));
         }
+        self.persist_meta(&meta_path, meta);
 
         Ok(())
     }
 
+    /// meta 点更新日志文件路径
+    fn get_meta_journal_path(&self) -> PathBuf {
+        self.rmm_root.join("meta.journal.jsonl")
+    }
+
+    /// 日志超过该大小时触发压缩（合并回 meta.toml 并清空日志）
+    const META_JOURNAL_COMPACT_BYTES: u64 = 64 * 1024;
+
+    /// 按顺序回放日志到给定状态，返回回放的操作数
+    fn replay_meta_journal(&self, meta: &mut MetaConfig) -> usize {
+        let Ok(content) = fs::read_to_string(self.get_meta_journal_path()) else {
+            return 0;
+        };
+        let mut applied = 0;
+        for line in content.lines() {
+            match serde_json::from_str::<MetaJournalOp>(line) {
+                Ok(MetaJournalOp::SetProject { name, path }) => {
+                    meta.projects.insert(name, path);
+                    applied += 1;
+                }
+                Ok(MetaJournalOp::RemoveProject { name }) => {
+                    meta.projects.remove(&name);
+                    applied += 1;
+                }
+                // 写入中断留下的半行直接忽略，后续压缩会清掉
+                Err(_) => {}
+            }
+        }
+        applied
+    }
+
+    /// 追加一条点更新：O(1) 写一行 JSON 而不是重写整个 meta.toml，
+    /// 并把操作同步应用到内存缓存；日志过大时顺手压缩
+    fn append_meta_journal(&self, op: MetaJournalOp) -> Result<()> {
+        let journal_path = self.get_meta_journal_path();
+        if let Some(parent) = journal_path.parent() {
+            fs::create_dir_all(parent)
+                .with_context(|| format!("Failed to create directory {}", parent.display()))?;
+        }
+
+        let mut line = serde_json::to_string(&op)
+            .with_context(|| "Failed to serialize meta journal op")?;
+        line.push('\n');
+
+        use std::io::Write;
+        let mut file = fs::OpenOptions::new()
+            .create(true)
+            .append(true)
+            .open(&journal_path)
+            .with_context(|| format!("Failed to open meta journal {}", journal_path.display()))?;
+        file.write_all(line.as_bytes())
+            .with_context(|| "Failed to append meta journal")?;
+        drop(file);
+
+        // 内存缓存就地应用同一操作，读路径无需重新回放
+        {
+            let mut cache = self.meta_cache.write().unwrap();
+            if let Some(item) = cache.as_mut() {
+                match &op {
+                    MetaJournalOp::SetProject { name, path } => {
+                        item.data.projects.insert(name.clone(), path.clone());
+                    }
+                    MetaJournalOp::RemoveProject { name } => {
+                        item.data.projects.remove(name);
+                    }
+                }
+            }
+        }
+
+        // 周期性压缩，避免日志无限增长拖慢回放
+        if fs::metadata(&journal_path).map(|m| m.len()).unwrap_or(0) > Self::META_JOURNAL_COMPACT_BYTES {
+            self.compact_meta_journal()?;
+        }
+        Ok(())
+    }
+
+    /// 将日志合并进 meta.toml 并清空日志，重建导出视图
+    pub fn compact_meta_journal(&self) -> Result<()> {
+        let meta = self.get_meta_config()?; // 已包含日志回放结果
+        self.update_meta_config(&meta) // 全量写出并截断日志
+    }
+
+    /// 点更新：注册/更新单个项目路径（O(1) 日志追加）
+    pub fn set_project_in_meta(&self, project_name: &str, project_path: &str) -> Result<()> {
+        self.append_meta_journal(MetaJournalOp::SetProject {
+            name: project_name.to_string(),
+            path: project_path.to_string(),
+        })
+    }
+
     /// 功能四：返回 meta.toml 文件内容的某个键的值
+    ///
+    /// 走 get_meta_config 而非直接读文件，保证已日志化但尚未压实的
+    /// 点更新对所有 meta 读取方一致可见。
     pub fn get_meta_value(&self, key: &str) -> Result<Option<toml::Value>> {
-        let meta_path = self.get_meta_path();
-        let content = fs::read_to_string(&meta_path)
-            .with_context(|| format!("Failed to read meta.toml from {}", meta_path.display()))?;
-        
-        let parsed: toml::Value = toml::from_str(&content)
-            .with_context(|| "Failed to parse meta.toml")?;
+        let meta = self.get_meta_config()?; // 已包含日志回放结果
+        let parsed = toml::Value::try_from(&meta)
+            .with_context(|| "Failed to serialize meta config")?;
 
         Ok(parsed.get(key).cloned())
     }    /// 功能五：给定项目名，返回路径
@@ -371,15 +738,55 @@ impl RmmCore {    /// 创建新的 RmmCore 实例
         Ok(meta.projects.get(project_name).map(|p| PathBuf::from(p)))
     }
 
+    /// 已知无效路径的负缓存：TTL 内跳过磁盘探测（慢速网络挂载上反复 stat 很昂贵）
+    fn negative_validity_cache() -> &'static Mutex<HashMap<PathBuf, Instant>> {
+        static CACHE: std::sync::OnceLock<Mutex<HashMap<PathBuf, Instant>>> = std::sync::OnceLock::new();
+        CACHE.get_or_init(|| Mutex::new(HashMap::new()))
+    }
+
+    /// 负缓存 TTL：无效路径 5 分钟内不再重新探测
+    const NEGATIVE_VALIDITY_TTL: Duration = Duration::from_secs(300);
+
+    /// 单个路径的磁盘探测超时：网络挂载卡死时不阻塞整批检查
+    const VALIDITY_PROBE_TIMEOUT: Duration = Duration::from_secs(2);
+
+    /// 带超时的单路径磁盘探测，返回 (是否有效, canonical 路径)
+    /// 超时视为无效；探测线程可能仍阻塞在慢速挂载上，但不再拖住调用方
+    fn probe_path_validity(project_path: &Path) -> (bool, Option<PathBuf>) {
+        let path = project_path.to_path_buf();
+        let (tx, rx) = std::sync::mpsc::channel();
+        std::thread::spawn(move || {
+            let valid = path.exists()
+                && path.is_dir()
+                && path.join("rmmproject.toml").exists()
+                && path.join(".rmmp").exists()
+                && path.join(".rmmp").join("Rmake.toml").exists();
+            let canonical = if valid { path.canonicalize().ok() } else { None };
+            let _ = tx.send((valid, canonical));
+        });
+        rx.recv_timeout(Self::VALIDITY_PROBE_TIMEOUT)
+            .unwrap_or((false, None))
+    }
+
     /// 功能六：检查各个项目是否有效（判断对应文件夹是否存在且包含 rmmproject.toml 文件）
+    /// 磁盘探测批量并行执行，单路径带超时，已知无效路径走 TTL 负缓存
     pub fn check_projects_validity(&self) -> Result<HashMap<String, bool>> {
+        use rayon::prelude::*;
+
         let meta = self.get_meta_config()?;
         let mut results = HashMap::new();
-        let mut canonical_paths = std::collections::HashSet::new();
+        let mut to_probe: Vec<(String, PathBuf)> = Vec::new();
+
+        let now = Instant::now();
+        {
+            // 过期的负缓存条目顺手清理
+            let mut negative = Self::negative_validity_cache().lock().unwrap();
+            negative.retain(|_, stamp| now.duration_since(*stamp) < Self::NEGATIVE_VALIDITY_TTL);
+        }
 
         for (name, path) in &meta.projects {
             let project_path = PathBuf::from(path);
-            
+
             // 1. 检查项目名称是否符合规范
             let name_valid = is_valid_project_name(name);
             if !name_valid {
@@ -388,10 +795,10 @@ impl RmmCore {    /// 创建新的 RmmCore 实例
                 results.insert(name.clone(), false);
                 continue;
             }
-            
+
             // 2. 黑名单检查 - 排除构建相关目录和系统目录
             let blacklisted_names = [
-                "build", "source-build", "dist", "target", "node_modules", 
+                "build", "source-build", "dist", "target", "node_modules",
                 ".git", ".vscode", "tmp", "temp", "cache", "output",
                 ".rmmp", "out", "bin", "obj", ".next", "coverage"
             ];
@@ -401,7 +808,7 @@ impl RmmCore {    /// 创建新的 RmmCore 实例
                 results.insert(name.clone(), false);
                 continue;
             }
-            
+
             // 3. 检查路径是否为 .rmmp 的子目录（构建产物）
             if project_path.ancestors().any(|ancestor| {
                 ancestor.file_name().map_or(false, |name| name == ".rmmp")
@@ -411,39 +818,204 @@ impl RmmCore {    /// 创建新的 RmmCore 实例
                 results.insert(name.clone(), false);
                 continue;
             }
-            
-            // 4. 检查项目路径和文件是否存在
-            let path_valid = project_path.exists() && 
-                           project_path.is_dir() && 
-                           project_path.join("rmmproject.toml").exists() &&
-                           project_path.join(".rmmp").exists() &&
-                           project_path.join(".rmmp").join("Rmake.toml").exists();
-            
-            if !path_valid {
+
+            // 4. 负缓存命中：TTL 内已知无效，跳过磁盘探测
+            {
+                let negative = Self::negative_validity_cache().lock().unwrap();
+                if negative.contains_key(&project_path) {
+                    #[cfg(debug_assertions)]
+                    eprintln!("⏭️  项目路径 '{}' 负缓存命中，跳过探测", path);
+                    results.insert(name.clone(), false);
+                    continue;
+                }
+            }
+
+            to_probe.push((name.clone(), project_path));
+        }
+
+        // 5. 批量并行磁盘探测（每个路径各自带超时）
+        let probed: Vec<(String, PathBuf, bool, Option<PathBuf>)> = to_probe
+            .into_par_iter()
+            .map(|(name, project_path)| {
+                let (valid, canonical) = Self::probe_path_validity(&project_path);
+                (name, project_path, valid, canonical)
+            })
+            .collect();
+
+        // 6. 汇总：记录负缓存并按 canonical 路径去重
+        let mut canonical_paths = std::collections::HashSet::new();
+        for (name, project_path, valid, canonical) in probed {
+            if !valid {
                 #[cfg(debug_assertions)]
-                eprintln!("❌ 项目路径 '{}' 无效或缺少必要文件", path);
-                results.insert(name.clone(), false);
+                eprintln!("❌ 项目路径 '{}' 无效或缺少必要文件", project_path.display());
+                Self::negative_validity_cache()
+                    .lock()
+                    .unwrap()
+                    .insert(project_path, Instant::now());
+                results.insert(name, false);
                 continue;
             }
-            
-            // 5. 检查路径重复（使用 canonicalize 解析真实路径）
-            if let Ok(canonical_path) = project_path.canonicalize() {
-                if canonical_paths.contains(&canonical_path) {
+
+            if let Some(canonical_path) = canonical {
+                if !canonical_paths.insert(canonical_path.clone()) {
                     #[cfg(debug_assertions)]
                     eprintln!("🚫 项目 '{}' 路径重复: {}", name, canonical_path.display());
-                    results.insert(name.clone(), false);
+                    results.insert(name, false);
                     continue;
                 }
-                canonical_paths.insert(canonical_path);
             }
-            
+
             // 所有检查都通过
-            results.insert(name.clone(), true);
+            results.insert(name, true);
         }
 
         Ok(results)
     }    /// 功能七：给定一个路径和遍历深度，扫描路径下是否含有 rmmp(project)
+    /// 默认使用并行扫描引擎（并行度 = 逻辑核心数）
     pub fn scan_projects(&self, scan_path: &Path, max_depth: Option<usize>) -> Result<Vec<ProjectScanResult>> {
+        self.scan_projects_with_parallelism(scan_path, max_depth, None)
+    }
+
+    /// 功能七（并行版）：带并行度控制的项目扫描
+    /// 目录遍历使用 rayon 工作窃取线程池，rmmproject.toml 探测、名称校验和 Git 信息分析
+    /// 都在工作线程内完成，扫描耗时随核心数扩展而不是随目录数线性增长
+    pub fn scan_projects_with_parallelism(
+        &self,
+        scan_path: &Path,
+        max_depth: Option<usize>,
+        max_parallelism: Option<usize>,
+    ) -> Result<Vec<ProjectScanResult>> {
+        // 并行度为 1 时没有并行收益，直接走顺序扫描，省掉线程池开销
+        if max_parallelism == Some(1) {
+            let mut results = self.scan_projects_sequential(scan_path, max_depth)?;
+            results.sort_by(|a, b| a.path.cmp(&b.path));
+            return Ok(results);
+        }
+
+        let pool = rayon::ThreadPoolBuilder::new()
+            .num_threads(max_parallelism.unwrap_or(0)) // 0 = rayon 默认（逻辑核心数）
+            .build()
+            .with_context(|| "Failed to build project scan thread pool")?;
+
+        let results = Mutex::new(Vec::new());
+        pool.install(|| {
+            Self::scan_dir_parallel(scan_path, max_depth, &results);
+        });
+
+        let mut results = results.into_inner().unwrap();
+
+        // 与顺序扫描保持一致：按 canonical 路径去重
+        let mut canonical_paths = std::collections::HashSet::new();
+        results.retain(|r: &ProjectScanResult| canonical_paths.insert(r.path.clone()));
+
+        // 并行遍历的完成顺序不确定，排序保证输出稳定
+        results.sort_by(|a, b| a.path.cmp(&b.path));
+
+        Ok(results)
+    }
+
+    /// 并行递归扫描单个目录：先探测当前目录，再将子目录分发到工作窃取线程池
+    fn scan_dir_parallel(dir: &Path, depth_remaining: Option<usize>, results: &Mutex<Vec<ProjectScanResult>>) {
+        use rayon::prelude::*;
+
+        // 跳过 .rmmp 目录下的所有子目录（这些是构建产物）
+        if dir.file_name().map_or(false, |name| name == ".rmmp") {
+            #[cfg(debug_assertions)]
+            eprintln!("⏭️  跳过 .rmmp 目录下的路径: {}", dir.display());
+            return;
+        }
+
+        // 探测当前目录是否是一个项目
+        if let Some(result) = Self::probe_project_dir(dir) {
+            results.lock().unwrap().push(result);
+        }
+
+        // 深度耗尽，不再下探
+        if depth_remaining == Some(0) {
+            return;
+        }
+        let next_depth = depth_remaining.map(|d| d - 1);
+
+        let subdirs: Vec<PathBuf> = match fs::read_dir(dir) {
+            Ok(entries) => entries
+                .filter_map(|e| e.ok())
+                .map(|e| e.path())
+                .filter(|p| p.is_dir())
+                .collect(),
+            Err(_) => return,
+        };
+
+        subdirs
+            .par_iter()
+            .for_each(|subdir| Self::scan_dir_parallel(subdir, next_depth, results));
+    }
+
+    /// 探测单个目录是否是合法的 RMM 项目（含名称校验与黑名单检查）
+    fn probe_project_dir(path: &Path) -> Option<ProjectScanResult> {
+        // 检查是否包含 rmmproject.toml
+        let project_file = path.join("rmmproject.toml");
+        if !project_file.exists() {
+            return None;
+        }
+
+        // 使用 canonicalize 解析真实路径
+        let canonical_path = match path.canonicalize() {
+            Ok(p) => p,
+            Err(_) => {
+                #[cfg(debug_assertions)]
+                eprintln!("⚠️  无法解析路径: {}", path.display());
+                return None;
+            }
+        };
+
+        let name = canonical_path.file_name()
+            .and_then(|n| n.to_str())
+            .unwrap_or("unknown")
+            .to_string();
+
+        #[cfg(debug_assertions)]
+        eprintln!("🔍 正在验证项目名称: '{}' 在路径: {} (canonical: {})", name, path.display(), canonical_path.display());
+
+        // 黑名单检查 - 排除构建相关目录
+        let blacklisted_names = [
+            "build", "source-build", "dist", "target", "node_modules",
+            ".git", ".vscode", "tmp", "temp", "cache", "output",
+            ".rmmp", "out", "bin", "obj", ".next", "coverage"
+        ];
+        if blacklisted_names.contains(&name.as_str()) {
+            #[cfg(debug_assertions)]
+            eprintln!("🚫 项目名称 '{}' 在黑名单中，跳过", name);
+            return None;
+        }
+
+        // 验证项目名称格式：必须符合 ^[a-zA-Z][a-zA-Z0-9._-]+$
+        if !is_valid_project_name(&name) {
+            #[cfg(debug_assertions)]
+            eprintln!("❌ 项目名称 '{}' 不符合命名规则，跳过", name);
+            return None;
+        }
+
+        #[cfg(debug_assertions)]
+        eprintln!("✅ 项目名称 '{}' 验证通过", name);
+
+        // 检查是否是完整的 RMM 项目
+        let rmmp_dir = path.join(".rmmp");
+        let rmake_file = rmmp_dir.join("Rmake.toml");
+        let is_valid = rmmp_dir.exists() && rmake_file.exists();
+
+        // 获取 Git 信息
+        let git_info = GitAnalyzer::analyze_git_info(path).ok().flatten();
+
+        Some(ProjectScanResult {
+            name,
+            path: canonical_path,
+            is_valid,
+            git_info,
+        })
+    }
+
+    /// 顺序扫描实现（max_parallelism = 1 时的回退路径）
+    fn scan_projects_sequential(&self, scan_path: &Path, max_depth: Option<usize>) -> Result<Vec<ProjectScanResult>> {
         let mut results = Vec::new();
         let mut canonical_paths = std::collections::HashSet::new(); // 防止重复路径
         
@@ -572,32 +1144,78 @@ impl RmmCore {    /// 创建新的 RmmCore 实例
     pub fn get_project_config(&self, project_path: &Path) -> Result<RmmProject> {
         let project_key = project_path.to_string_lossy().to_string();
         
-        // 检查缓存
+        // 检查缓存（分片锁读取，仅在命中同一分片写入时才会短暂阻塞）
         {
-            let cache = self.project_cache.lock().unwrap();
-            if let Some(cached) = cache.get(&project_key) {
-                if !cached.is_expired() {
-                    return Ok(cached.data.clone());
+            use dashmap::try_result::TryResult;
+            use std::sync::atomic::Ordering::Relaxed;
+            match self.project_cache.try_get(&project_key) {
+                TryResult::Present(cached) => {
+                    if !cached.is_expired() {
+                        self.metrics.project.hits.fetch_add(1, Relaxed);
+                        return Ok(cached.data.clone());
+                    }
+                    self.metrics.project.expired.fetch_add(1, Relaxed);
+                }
+                TryResult::Absent => {}
+                TryResult::Locked => {
+                    self.contention.project.fetch_add(1, Relaxed);
+                    if let Some(cached) = self.project_cache.get(&project_key) {
+                        if !cached.is_expired() {
+                            self.metrics.project.hits.fetch_add(1, Relaxed);
+                            return Ok(cached.data.clone());
+                        }
+                        self.metrics.project.expired.fetch_add(1, Relaxed);
+                    }
                 }
             }
         }
+        self.metrics.project.misses.fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+        let load_start = Instant::now();
 
         let project_file = project_path.join("rmmproject.toml");
+
+        // 检查持久化缓存
+        if let Some(stamp) = Self::file_stamp(&project_file) {
+            let cache = self.persistent_cache().lock().unwrap();
+            if let Some(entry) = cache.projects.get(&project_key) {
+                if (entry.mtime_ns, entry.size) == stamp {
+                    let project = entry.data.clone();
+                    drop(cache);
+                    self.project_cache
+                        .insert(project_key, CacheItem::new(project.clone(), self.cache_ttl));
+                    self.metrics.project.record_load(load_start.elapsed());
+                    return Ok(project);
+                }
+            }
+        }
+
         let content = fs::read_to_string(&project_file)
             .with_context(|| format!("Failed to read rmmproject.toml from {}", project_file.display()))?;
-        
+
         let project: RmmProject = toml::from_str(&content)
             .with_context(|| "Failed to parse rmmproject.toml")?;
 
         // 更新缓存
-        {
-            let mut cache = self.project_cache.lock().unwrap();
-            cache.insert(project_key, CacheItem::new(project.clone(), self.cache_ttl));
-        }
+        self.project_cache
+            .insert(project_key.clone(), CacheItem::new(project.clone(), self.cache_ttl));
+        self.persist_project(&project_file, &project_key, &project);
+        self.metrics.project.record_load(load_start.elapsed());
 
         Ok(project)
     }
 
+    /// 将项目配置写入持久化缓存
+    fn persist_project(&self, project_file: &Path, project_key: &str, project: &RmmProject) {
+        if let Some((mtime_ns, size)) = Self::file_stamp(project_file) {
+            let mut cache = self.persistent_cache().lock().unwrap();
+            cache.projects.insert(
+                project_key.to_string(),
+                PersistentEntry { mtime_ns, size, data: project.clone() },
+            );
+            self.mark_persistent_dirty();
+        }
+    }
+
     /// 写入项目的 rmmproject.toml
     pub fn update_project_config(&self, project_path: &Path, project: &RmmProject) -> Result<()> {
         let project_file = project_path.join("rmmproject.toml");
@@ -610,10 +1228,9 @@ impl RmmCore {    /// 创建新的 RmmCore 实例
 
         // 更新缓存
         let project_key = project_path.to_string_lossy().to_string();
-        {
-            let mut cache = self.project_cache.lock().unwrap();
-            cache.insert(project_key, CacheItem::new(project.clone(), self.cache_ttl));
-        }
+        self.project_cache
+            .insert(project_key.clone(), CacheItem::new(project.clone(), self.cache_ttl));
+        self.persist_project(&project_file, &project_key, project);
 
         Ok(())
     }
@@ -621,15 +1238,41 @@ impl RmmCore {    /// 创建新的 RmmCore 实例
     /// 功能十：读取项目目录下的 module.prop（以 TOML 格式）
     pub fn get_module_prop(&self, project_path: &Path) -> Result<ModuleProp> {
         let prop_file = project_path.join("module.prop");
+        let prop_key = prop_file.to_string_lossy().to_string();
+
+        // 检查持久化缓存
+        if let Some(stamp) = Self::file_stamp(&prop_file) {
+            let cache = self.persistent_cache().lock().unwrap();
+            if let Some(entry) = cache.module_props.get(&prop_key) {
+                if (entry.mtime_ns, entry.size) == stamp {
+                    return Ok(entry.data.clone());
+                }
+            }
+        }
+
         let content = fs::read_to_string(&prop_file)
             .with_context(|| format!("Failed to read module.prop from {}", prop_file.display()))?;
-        
+
         let prop: ModuleProp = toml::from_str(&content)
             .with_context(|| "Failed to parse module.prop")?;
 
+        self.persist_module_prop(&prop_file, &prop_key, &prop);
+
         Ok(prop)
     }
 
+    /// 将 module.prop 写入持久化缓存
+    fn persist_module_prop(&self, prop_file: &Path, prop_key: &str, prop: &ModuleProp) {
+        if let Some((mtime_ns, size)) = Self::file_stamp(prop_file) {
+            let mut cache = self.persistent_cache().lock().unwrap();
+            cache.module_props.insert(
+                prop_key.to_string(),
+                PersistentEntry { mtime_ns, size, data: prop.clone() },
+            );
+            self.mark_persistent_dirty();
+        }
+    }
+
     /// 写入项目目录下的 module.prop
     pub fn update_module_prop(&self, project_path: &Path, prop: &ModuleProp) -> Result<()> {
         let prop_file = project_path.join("module.prop");
@@ -640,6 +1283,9 @@ impl RmmCore {    /// 创建新的 RmmCore 实例
         fs::write(&prop_file, content)
             .with_context(|| format!("Failed to write module.prop to {}", prop_file.display()))?;
 
+        let prop_key = prop_file.to_string_lossy().to_string();
+        self.persist_module_prop(&prop_file, &prop_key, prop);
+
         Ok(())
     }
 
@@ -742,7 +1388,7 @@ impl RmmCore {    /// 创建新的 RmmCore 实例
     pub fn cleanup_expired_cache(&self) {
         // 清理 meta 缓存
         {
-            let mut cache = self.meta_cache.lock().unwrap();
+            let mut cache = self.meta_cache.write().unwrap();
             if let Some(cached) = cache.as_ref() {
                 if cached.is_expired() {
                     *cache = None;
@@ -751,26 +1397,88 @@ impl RmmCore {    /// 创建新的 RmmCore 实例
         }
 
         // 清理项目缓存
-        {
-            let mut cache = self.project_cache.lock().unwrap();
-            cache.retain(|_, cached| !cached.is_expired());
-        }
+        self.project_cache.retain(|_, cached| !cached.is_expired());
     }
 
     /// 获取缓存统计信息
     pub fn get_cache_stats(&self) -> (bool, usize) {
         let meta_cached = {
-            let cache = self.meta_cache.lock().unwrap();
+            let cache = self.meta_cache.read().unwrap();
             cache.is_some() && !cache.as_ref().unwrap().is_expired()
         };
 
-        let project_count = {
-            let cache = self.project_cache.lock().unwrap();
-            cache.len()
-        };
+        let project_count = self.project_cache.len();
 
         (meta_cached, project_count)
     }
+
+    /// 获取完整的缓存观测指标（JSON）：
+    /// 每个缓存的命中/未命中/过期计数、加载延迟（均值/最大/直方图）、
+    /// 近似持有字节数，以及锁竞争计数，用于对照真实负载调 TTL
+    pub fn get_cache_metrics(&self) -> serde_json::Value {
+        // 近似字节数：缓存数据序列化后的大小（统计口径，不追求精确堆占用）
+        let (meta_cached, meta_bytes) = {
+            let cache = self.meta_cache.read().unwrap();
+            match cache.as_ref() {
+                Some(item) => (true, serde_json::to_vec(&item.data).map(|v| v.len()).unwrap_or(0)),
+                None => (false, 0),
+            }
+        };
+
+        let mut project_bytes = 0usize;
+        for entry in self.project_cache.iter() {
+            project_bytes += serde_json::to_vec(&entry.value().data).map(|v| v.len()).unwrap_or(0);
+        }
+
+        let mut git_bytes = 0usize;
+        for entry in self.git_cache.iter() {
+            let (info, _) = entry.value();
+            git_bytes += std::mem::size_of::<GitInfo>()
+                + info.repo_root.as_os_str().len()
+                + info.relative_path.as_os_str().len()
+                + info.branch.len()
+                + info.remote_url.as_ref().map(|s| s.len()).unwrap_or(0)
+                + info.last_commit_hash.as_ref().map(|s| s.len()).unwrap_or(0)
+                + info.last_commit_message.as_ref().map(|s| s.len()).unwrap_or(0);
+        }
+
+        let attach = |counters: &CacheCounters, extra: serde_json::Value| {
+            let mut json = counters.to_json();
+            if let (Some(obj), Some(extra_obj)) = (json.as_object_mut(), extra.as_object()) {
+                for (key, value) in extra_obj {
+                    obj.insert(key.clone(), value.clone());
+                }
+            }
+            json
+        };
+
+        serde_json::json!({
+            "cache_ttl_secs": self.cache_ttl.as_secs(),
+            "meta": attach(&self.metrics.meta, serde_json::json!({
+                "cached": meta_cached,
+                "approx_bytes": meta_bytes,
+            })),
+            "project": attach(&self.metrics.project, serde_json::json!({
+                "entries": self.project_cache.len(),
+                "approx_bytes": project_bytes,
+            })),
+            "git": attach(&self.metrics.git, serde_json::json!({
+                "entries": self.git_cache.len(),
+                "approx_bytes": git_bytes,
+            })),
+            "lock_contention": self.get_cache_contention(),
+        })
+    }
+
+    /// 获取各缓存的锁竞争计数（自进程启动起累计的慢路径命中次数）
+    pub fn get_cache_contention(&self) -> HashMap<String, u64> {
+        use std::sync::atomic::Ordering;
+        let mut stats = HashMap::new();
+        stats.insert("meta".to_string(), self.contention.meta.load(Ordering::Relaxed));
+        stats.insert("project".to_string(), self.contention.project.load(Ordering::Relaxed));
+        stats.insert("git".to_string(), self.contention.git.load(Ordering::Relaxed));
+        stats
+    }
 }
 
 impl Default for RmmCore {
@@ -859,6 +1567,8 @@ impl RmmCore {
                 prebuild: vec!["echo 'Starting build'".to_string()],
                 build: vec!["rmm".to_string()],
                 postbuild: vec!["echo 'Build completed'".to_string()],
+                compression: None,
+                source_format: None,
                 src: Some(SrcConfig {
                     include: vec!["# 源代码额外包含的文件，如：\"docs/\"".to_string()],
                     exclude: vec![
@@ -879,24 +1589,42 @@ impl RmmCore {/// 检测给定路径是否在 Git 仓库中，并返回详细信
         let canonical_path = path.canonicalize()
             .map_err(|e| anyhow::anyhow!("无法获取路径的绝对路径: {}", e))?;
         
-        // 检查缓存
+        // 检查缓存（分片锁读取）
         {
-            let cache = self.git_cache.lock().unwrap();
-            if let Some((git_info, cached_time)) = cache.get(&canonical_path) {
-                if cached_time.elapsed() < self.cache_ttl {
-                    return Ok(git_info.clone());
+            use dashmap::try_result::TryResult;
+            use std::sync::atomic::Ordering::Relaxed;
+            match self.git_cache.try_get(&canonical_path) {
+                TryResult::Present(entry) => {
+                    let (git_info, cached_time) = entry.value();
+                    if cached_time.elapsed() < self.cache_ttl {
+                        self.metrics.git.hits.fetch_add(1, Relaxed);
+                        return Ok(git_info.clone());
+                    }
+                    self.metrics.git.expired.fetch_add(1, Relaxed);
+                }
+                TryResult::Absent => {}
+                TryResult::Locked => {
+                    self.contention.git.fetch_add(1, Relaxed);
+                    if let Some(entry) = self.git_cache.get(&canonical_path) {
+                        let (git_info, cached_time) = entry.value();
+                        if cached_time.elapsed() < self.cache_ttl {
+                            self.metrics.git.hits.fetch_add(1, Relaxed);
+                            return Ok(git_info.clone());
+                        }
+                        self.metrics.git.expired.fetch_add(1, Relaxed);
+                    }
                 }
             }
         }
-        
+        self.metrics.git.misses.fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+        let load_start = Instant::now();
+
         let git_info = self.analyze_git_info(&canonical_path)?;
-        
+
         // 更新缓存
-        {
-            let mut cache = self.git_cache.lock().unwrap();
-            cache.insert(canonical_path, (git_info.clone(), Instant::now()));
-        }
-        
+        self.git_cache.insert(canonical_path, (git_info.clone(), Instant::now()));
+        self.metrics.git.record_load(load_start.elapsed());
+
         Ok(git_info)
     }
     
@@ -1059,43 +1787,44 @@ impl RmmCore {/// 检测给定路径是否在 Git 仓库中，并返回详细信
     
     /// 清理 Git 缓存
     pub fn clear_git_cache(&self) {
-        let mut cache = self.git_cache.lock().unwrap();
-        cache.clear();
+        self.git_cache.clear();
     }
-    
+
     /// 清理过期的 Git 缓存项
     pub fn cleanup_expired_git_cache(&self) {
-        let mut cache = self.git_cache.lock().unwrap();
         let now = Instant::now();
-        cache.retain(|_, (_, cached_time)| now.duration_since(*cached_time) < self.cache_ttl);
+        self.git_cache
+            .retain(|_, (_, cached_time)| now.duration_since(*cached_time) < self.cache_ttl);
     }
 }
 
 impl RmmCore {    /// 从meta配置中移除项目
     pub fn remove_project_from_meta(&self, project_name: &str) -> Result<bool> {
-        let mut meta = self.get_meta_config()?;
-        let removed = meta.projects.remove(project_name).is_some();
+        let meta = self.get_meta_config()?;
+        let removed = meta.projects.contains_key(project_name);
         if removed {
-            self.update_meta_config(&meta)?;
+            // 点更新：追加一条日志而不是重写整个 meta.toml
+            self.append_meta_journal(MetaJournalOp::RemoveProject {
+                name: project_name.to_string(),
+            })?;
         }
         Ok(removed)
     }
 
     /// 从meta配置中移除多个项目
     pub fn remove_projects_from_meta(&self, project_names: &[&str]) -> Result<Vec<String>> {
-        let mut meta = self.get_meta_config()?;
+        let meta = self.get_meta_config()?;
         let mut removed = Vec::new();
-        
+
         for &project_name in project_names {
-            if meta.projects.remove(project_name).is_some() {
+            if meta.projects.contains_key(project_name) {
+                self.append_meta_journal(MetaJournalOp::RemoveProject {
+                    name: project_name.to_string(),
+                })?;
                 removed.push(project_name.to_string());
             }
         }
-        
-        if !removed.is_empty() {
-            self.update_meta_config(&meta)?;
-        }
-        
+
         Ok(removed)
     }
 
@@ -1120,17 +1849,27 @@ impl RmmCore {    /// 从meta配置中移除项目
     /// 清除所有缓存，强制重新读取
     pub fn clear_cache(&self) {
         {
-            let mut cache = self.meta_cache.lock().unwrap();
+            let mut cache = self.meta_cache.write().unwrap();
             *cache = None;
         }
+        self.project_cache.clear();
+        self.git_cache.clear();
+        // 持久化缓存一并清空，并删除磁盘上的缓存文件
         {
-            let mut cache = self.project_cache.lock().unwrap();
-            cache.clear();
-        }
-        {
-            let mut cache = self.git_cache.lock().unwrap();
-            cache.clear();
+            let mut cache = self.persistent_cache().lock().unwrap();
+            *cache = PersistentConfigCache::default();
         }
+        self.persistent_dirty.store(false, std::sync::atomic::Ordering::SeqCst);
+        let _ = fs::remove_file(Self::persistent_cache_path(&self.rmm_root));
+        // 有效性负缓存一并清空
+        Self::negative_validity_cache().lock().unwrap().clear();
+    }
+}
+
+impl Drop for RmmCore {
+    /// 进程退出前把持久化缓存落盘，供下一次 CLI 调用复用
+    fn drop(&mut self) {
+        self.flush_persistent_cache();
     }
 }
 
@@ -3,8 +3,9 @@
 use pyo3::prelude::*;
 use std::path::PathBuf;
 
-mod cmds;
-mod core;
+// pub 以便 benches/ 下的 criterion 基准能够链接热路径
+pub mod cmds;
+pub mod core;
 
 use cmds::{Commands, RmmBox};
 use core::python_bindings::PyRmmCore;
@@ -33,9 +34,25 @@ struct Cli {
 /// CLI 入口函数
 #[pyfunction]
 fn cli() -> PyResult<()> {
-    let args = Cli::parse_from(std::env::args().skip(1));
+    let raw_args: Vec<String> = std::env::args().skip(1).collect();
+
+    // 快速路径：version 等无参调用不构建 clap 命令树、不触碰任何配置文件
+    // （shell 集成会频繁调用 rmm 做提示符装饰，启动延迟是用户可感知的）
+    if raw_args.len() == 2 {
+        if let Some(cmd) = raw_args.get(1).map(|s| s.as_str()) {
+            match cmd {
+                "version" | "-V" | "--version" => {
+                    RmmBox::rmm_version();
+                    return Ok(());
+                }
+                _ => {}
+            }
+        }
+    }
+
+    let args = Cli::parse_from(raw_args);
     match args.cmd {        // 初始化命令
-        Some(Commands::Init { project_id }) => {
+        Some(Commands::Init { project_id, template }) => {
             // 获取当前目录
             let current_dir = std::env::current_dir().map_err(|e| 
                 pyo3::exceptions::PyRuntimeError::new_err(format!("无法获取当前目录: {}", e))
@@ -82,7 +99,7 @@ fn cli() -> PyResult<()> {
                     ("unknown".to_string(), "unknown@example.com".to_string())
                 }
             };
-              match cmds::init::init_project(&project_path, &actual_project_id, &author_name, &author_email) {
+              match cmds::init::init_project_with_template(&project_path, &actual_project_id, &author_name, &author_email, &template) {
                 Ok(()) => {
                     // 更新 meta 配置中的 projects (ID = PATH)
                     if let Err(e) = update_meta_projects(&core, &actual_project_id, &project_path) {
@@ -96,7 +113,18 @@ fn cli() -> PyResult<()> {
             }
         },
           // 构建命令
-        Some(Commands::Build { project_path, no_auto_fix, script }) => {
+        Some(Commands::Build { project_path, no_auto_fix, incremental, streaming, watch, timings, all, jobs, script }) => {
+            // 批量模式：构建 meta 中注册的所有项目
+            if all {
+                let auto_fix = !no_auto_fix;
+                let options = cmds::build::BuildOptions { auto_fix, incremental, streaming, timings };
+                if let Err(e) = cmds::build::build_all_projects(&options, jobs) {
+                    eprintln!("❌ 批量构建失败: {}", e);
+                    return Err(pyo3::exceptions::PyRuntimeError::new_err(format!("批量构建失败: {}", e)));
+                }
+                return Ok(());
+            }
+
             // 确定项目路径
             let target_path = if let Some(path) = project_path {
                 PathBuf::from(path)
@@ -143,7 +171,18 @@ fn cli() -> PyResult<()> {
             } else {
                 // 执行构建，传递自动修复参数
                 let auto_fix = !no_auto_fix;  // 默认启用自动修复，除非用户明确禁用
-                match cmds::build::build_project_with_options(&project_path, auto_fix) {
+                let options = cmds::build::BuildOptions { auto_fix, incremental, streaming, timings };
+
+                // 监视模式：常驻循环，直到 Ctrl+C
+                if watch {
+                    if let Err(e) = cmds::build::watch_project(&project_path, &options) {
+                        eprintln!("❌ 监视构建失败: {}", e);
+                        return Err(pyo3::exceptions::PyRuntimeError::new_err(format!("监视构建失败: {}", e)));
+                    }
+                    return Ok(());
+                }
+
+                match cmds::build::build_project_with(&project_path, &options) {
                     Ok(()) => {
                         println!("{} 构建成功！", "✅".green().bold());
                     }                    Err(e) => {
@@ -180,6 +219,29 @@ fn cli() -> PyResult<()> {
             }
         },
         
+        // 流式校验构建产物
+        Some(Commands::Check { project_path, artifact }) => {
+            // 确定项目路径
+            let target_path = if let Some(path) = project_path {
+                PathBuf::from(path)
+            } else {
+                std::env::current_dir().map_err(|e|
+                    pyo3::exceptions::PyRuntimeError::new_err(format!("无法获取当前目录: {}", e))
+                )?
+            };
+
+            // 规范化路径
+            let project_path = target_path.canonicalize().unwrap_or(target_path);
+
+            match cmds::check::check_artifact(&project_path, artifact.as_deref()) {
+                Ok(()) => {}
+                Err(e) => {
+                    eprintln!("❌ 校验失败: {}", e);
+                    return Err(pyo3::exceptions::PyRuntimeError::new_err(format!("校验失败: {}", e)));
+                }
+            }
+        },
+
         // 同步项目元数据命令
         Some(Commands::Sync { project_name, projects_only, search_paths, max_depth }) => {
             // 转换 search_paths 为 &str 类型
@@ -203,6 +265,20 @@ fn cli() -> PyResult<()> {
                 }
             }        },
         
+        // 输出缓存观测指标
+        Some(Commands::CacheStats) => {
+            let core = core::rmm_core::RmmCore::new();
+            // 预热一次 meta 读取，让指标里至少有一轮真实的加载数据
+            let _ = core.get_meta_config();
+            match serde_json::to_string_pretty(&core.get_cache_metrics()) {
+                Ok(json) => println!("{}", json),
+                Err(e) => {
+                    eprintln!("❌ 序列化缓存指标失败: {}", e);
+                    return Err(pyo3::exceptions::PyRuntimeError::new_err(format!("序列化缓存指标失败: {}", e)));
+                }
+            }
+        },
+
         // 显示版本信息
         Some(Commands::Version) => {
             RmmBox::rmm_version();
@@ -303,6 +379,9 @@ fn rmmcore(m: &Bound<'_, PyModule>) -> PyResult<()> {
     
     // 添加 RmmCore 类
     m.add_class::<PyRmmCore>()?;
-    
+
+    // 添加懒转换的扫描结果类
+    m.add_class::<core::python_bindings::PyProjectScanResult>()?;
+
     Ok(())
 }
\ No newline at end of file
@@ -0,0 +1,6 @@
+#!/system/bin/sh
+# KernelSU 模块自定义安装脚本（最小模板）
+
+ui_print "- 设备架构: $ARCH"
+ui_print "- Android API: $API"
+ui_print "- 模块安装完成"
@@ -1,17 +1,26 @@
 from pathlib import Path
 import os
+import threading
 import toml
 from typing import Any
 from contextlib import contextmanager
 from argparse import ArgumentParser
 from mcp.server.fastmcp import FastMCP
 
+try:
+    from watchdog.observers import Observer
+    from watchdog.events import FileSystemEventHandler
+    _WATCHDOG_AVAILABLE = True
+except ImportError:
+    # watchdog 不可用时回退到 stat 轮询
+    _WATCHDOG_AVAILABLE = False
+
 
 class RmMcp(FastMCP):
     """
     RmMcp class that extends FastMCP with configuration management capabilities.
     """
-    
+
     def __init__(self, name: str = "RmMcp", host: str = "localhost", port: int = 8000):
         super().__init__(name)
         self.host = host
@@ -24,6 +33,12 @@ class RmMcp(FastMCP):
             "projects": {}
         }
         self._cache_last_modified: float = 0
+        # 事件驱动的缓存失效：监视器把 meta.toml 的变动推成脏标记，
+        # 稳态下工具调用直接答内存缓存，零 stat 调用
+        self._meta_lock = threading.Lock()
+        self._meta_dirty: bool = True
+        self._watcher: Any = None
+        self._watcher_failed: bool = False
 
     @property
     def ROOT(self) -> Path:
@@ -54,18 +69,71 @@ class RmMcp(FastMCP):
             return True
         return False
 
+    def _ensure_watcher(self) -> bool:
+        """
+        懒启动 meta.toml 的文件监视器；watchdog 不可用或启动失败时返回 False，
+        调用方回退到 stat 轮询。
+        """
+        if self._watcher is not None:
+            return True
+        if self._watcher_failed or not _WATCHDOG_AVAILABLE:
+            return False
+
+        try:
+            self.ROOT.mkdir(parents=True, exist_ok=True)
+            meta_name = self.META_FILE.name
+            rmmcp_self = self
+
+            class _MetaHandler(FileSystemEventHandler):
+                def on_any_event(self, event: Any) -> None:
+                    # 只关心 meta.toml（编辑器可能以临时文件+重命名方式写入）
+                    paths = [getattr(event, "src_path", ""), getattr(event, "dest_path", "")]
+                    if any(p and Path(str(p)).name == meta_name for p in paths):
+                        rmmcp_self._meta_dirty = True
+
+            observer = Observer()
+            observer.daemon = True
+            observer.schedule(_MetaHandler(), str(self.ROOT), recursive=False)
+            observer.start()
+            self._watcher = observer
+            return True
+        except Exception:
+            self._watcher_failed = True
+            return False
+
+    def stop_watcher(self) -> None:
+        """停止文件监视器（服务器退出时调用）。"""
+        if self._watcher is not None:
+            self._watcher.stop()
+            self._watcher = None
+
+    def _load_meta(self) -> None:
+        """从磁盘重新加载 meta.toml 到内存缓存。"""
+        try:
+            with open(self.META_FILE, "r", encoding="utf-8") as f:
+                self.cache = toml.load(f)
+            self._cache_last_modified = self._true_last_modified
+        except FileNotFoundError:
+            # If file doesn't exist, create the directory and use default cache
+            self.ROOT.mkdir(parents=True, exist_ok=True)
+
     @property
     def META(self) -> dict[str, Any]:
         """
         Get the metadata from the TOML file, loading it if necessary.
         """
+        if self._ensure_watcher():
+            # 事件驱动路径：只有监视器标记过脏才重新读取
+            if self._meta_dirty:
+                with self._meta_lock:
+                    if self._meta_dirty:
+                        self._load_meta()
+                        self._meta_dirty = False
+            return self.cache
+
+        # 回退路径：按 mtime 轮询
         if self._cache_last_modified == 0 or self._true_last_modified == 0 or self.is_changed:
-            try:
-                with open(self.META_FILE, "r", encoding="utf-8") as f:
-                    self.cache = toml.load(f)
-            except FileNotFoundError:
-                # If file doesn't exist, create the directory and use default cache
-                self.ROOT.mkdir(parents=True, exist_ok=True)        
+            self._load_meta()
         return self.cache
     
     @property
@@ -282,6 +350,8 @@ def start_mcp_server(transport: str = "stdio", host: str = "localhost", port: in
         if verbose:
             print(f"❌ MCP 服务器错误: {e}")
         raise
+    finally:
+        mcp.stop_watcher()
 
 
 def rmmcp():
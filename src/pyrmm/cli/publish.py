@@ -1,8 +1,10 @@
 # rmm publish python 拓展命令
+import hashlib
 import os
 from pathlib import Path
 import platform
 from typing import Any
+from concurrent.futures import ThreadPoolExecutor, as_completed
 import subprocess
 import re
 import json
@@ -203,6 +205,31 @@ def sync_repo_to_toml(project_path: Path, github_url: str) -> None:
     rmmproject_file.write_text(content, encoding="utf-8")
     success(f"已将仓库地址同步到 rmmproject.toml: {github_url}")
 
+def _file_sha256(path: Path) -> str:
+    """计算文件的 SHA256，用于上传状态校验"""
+    digest = hashlib.sha256()
+    with open(path, "rb") as f:
+        for chunk in iter(lambda: f.read(1024 * 1024), b""):
+            digest.update(chunk)
+    return digest.hexdigest()
+
+def _load_upload_state(state_file: Path) -> dict[str, Any]:
+    """读取上传状态文件（缺失或损坏时返回空状态）"""
+    try:
+        with open(state_file, "r", encoding="utf-8") as f:
+            return json.load(f)
+    except (OSError, json.JSONDecodeError):
+        return {}
+
+def _save_upload_state(state_file: Path, state: dict[str, Any]) -> None:
+    """保存上传状态文件，失败不影响发布流程"""
+    try:
+        state_file.parent.mkdir(parents=True, exist_ok=True)
+        with open(state_file, "w", encoding="utf-8") as f:
+            json.dump(state, f, indent=2)
+    except OSError:
+        pass
+
 # rmmcore会调用这里
 def publish(args: list[Any]) -> None:
     """
@@ -351,27 +378,58 @@ def publish(args: list[Any]) -> None:
                     prerelease=False
                 )
                 success(f"✅ 已创建 Release: {release.html_url}")
-              # 上传文件到 Release
+              # 上传文件到 Release（并行上传 + 断点续传）
             print("正在上传文件...")
-            for target_file in target_files:
-                try:
-                    # 检查是否已存在同名文件，如果存在则删除
-                    existing_assets = release.get_assets()
-                    for asset in existing_assets:
-                        if asset.name == target_file.name:
-                            print(f"🔄 删除已存在的文件: {asset.name}")
-                            asset.delete_asset()
-                            break
-                      # 上传新文件
-                    with open(target_file, "rb") as f:
-                        asset = release.upload_asset(
-                            path=str(target_file),
-                            label=target_file.name
-                        )
-                    info(f"✅ 已上传文件: {target_file.name}")
-                    info(f"   下载链接: {asset.browser_download_url}")
-                except Exception as e:
-                    error(f"❌ 上传文件 {target_file.name} 失败: {e}")
+            state_file = project_path / ".rmmp" / "publish-state.json"
+            upload_state = _load_upload_state(state_file)
+            tag_state: dict[str, Any] = upload_state.setdefault(tag_name, {})
+
+            # 一次性取回已有资产列表，避免每个文件一轮 API 调用
+            existing_assets = {asset.name: asset for asset in release.get_assets()}
+
+            def upload_one(target_file: Path) -> None:
+                digest = _file_sha256(target_file)
+                recorded = tag_state.get(target_file.name)
+                existing = existing_assets.get(target_file.name)
+
+                # 断点续传：该文件在此 tag 下已按相同内容上传过，直接跳过
+                if existing is not None and recorded and recorded.get("sha256") == digest:
+                    info(f"⏭️  跳过已上传的文件: {target_file.name}")
+                    return
+
+                # 内容有变化或状态未知：删除旧资产后重新上传
+                if existing is not None:
+                    print(f"🔄 删除已存在的文件: {existing.name}")
+                    existing.delete_asset()
+
+                asset = release.upload_asset(
+                    path=str(target_file),
+                    label=target_file.name
+                )
+                tag_state[target_file.name] = {
+                    "sha256": digest,
+                    "size": target_file.stat().st_size,
+                }
+                info(f"✅ 已上传文件: {target_file.name}")
+                info(f"   下载链接: {asset.browser_download_url}")
+
+            failures = 0
+            max_workers = min(4, len(target_files)) or 1
+            with ThreadPoolExecutor(max_workers=max_workers) as executor:
+                futures = {executor.submit(upload_one, f): f for f in target_files}
+                for future in as_completed(futures):
+                    target_file = futures[future]
+                    try:
+                        future.result()
+                    except Exception as e:
+                        failures += 1
+                        error(f"❌ 上传文件 {target_file.name} 失败: {e}")
+                    finally:
+                        # 每个文件完成后立即落盘，中断后重跑可跳过已完成的部分
+                        _save_upload_state(state_file, upload_state)
+
+            if failures:
+                warning(f"{failures} 个文件上传失败，重新运行 publish 将跳过已完成的文件")
             success(f"🎉 发布完成！")
             info(f"Release 链接: {release.html_url}")
 
@@ -398,14 +456,17 @@ def proxy_handler(path: Path, target_files: list[Path], release_body: str, repo_
         str: 处理后的 Release 描述内容
     """
     try:
-        from ..utils.proxy import get_github_proxies, get_best_github_proxy
-        
-        # 获取代理列表和最佳代理
+        from ..utils.proxy import get_github_proxies, get_best_github_proxy, race_best_github_proxy
+
+        # 获取代理列表；竞速并发探测前几名镜像，最坏等待一轮探测而不是逐个超时
         proxies = get_github_proxies()
-        best_proxy = get_best_github_proxy()
-        
+        best_proxy = race_best_github_proxy(top_n=5)
+        if best_proxy is None:
+            # 竞速全部失败时回退到完整探测/API评分
+            best_proxy = get_best_github_proxy()
+
         info(f"使用最佳代理: {best_proxy}")
-        
+
     except ImportError:
         warning("代理模块未找到，使用默认代理")
         # 回退到默认代理列表
@@ -7,6 +7,34 @@ from __future__ import annotations
 from typing import Any
 
 
+class ProjectScanResult:
+    """
+    懒转换的项目扫描结果
+
+    字段保存在 Rust 侧，属性访问时才转换为 Python 对象
+    """
+
+    @property
+    def name(self) -> str:
+        """项目名称"""
+        ...
+
+    @property
+    def path(self) -> str:
+        """项目路径"""
+        ...
+
+    @property
+    def is_valid(self) -> bool:
+        """项目是否有效"""
+        ...
+
+    @property
+    def git_info(self) -> dict[str, Any] | None:
+        """Git 信息（按需转换，无仓库时返回 None）"""
+        ...
+
+
 class RmmCore:
     """
     RMM (Root Module Manager) 核心管理类
@@ -98,19 +126,34 @@ class RmmCore:
         """
         ...
     
-    def scan_projects(self, scan_path: str, max_depth: int | None = None) -> list[dict[str, Any]]:
+    def scan_projects(self, scan_path: str, max_depth: int | None = None, max_parallelism: int | None = None) -> list[dict[str, Any]]:
         """
-        扫描指定路径下的项目
-        
+        扫描指定路径下的项目（并行扫描引擎）
+
         Args:
             scan_path: 要扫描的路径
             max_depth: 最大扫描深度，None 表示无限制
-            
+            max_parallelism: 扫描线程数，None 表示使用逻辑核心数
+
         Returns:
             包含项目信息的字典列表，每个字典包含 name, path, is_valid 等字段
         """
         ...
-    
+
+    def scan_projects_lazy(self, scan_path: str, max_depth: int | None = None, max_parallelism: int | None = None) -> list[ProjectScanResult]:
+        """
+        扫描指定路径下的项目（懒转换版本）
+
+        Args:
+            scan_path: 要扫描的路径
+            max_depth: 最大扫描深度，None 表示无限制
+            max_parallelism: 扫描线程数，None 表示使用逻辑核心数
+
+        Returns:
+            ProjectScanResult 对象列表，字段在属性访问时才转换
+        """
+        ...
+
     def sync_projects(self, scan_paths: list[str], max_depth: int | None = None) -> None:
         """
         同步项目列表到 meta.toml
@@ -337,4 +380,5 @@ class RmmCore:
 # 导出的类型
 __all__ = [
     'RmmCore',
+    'ProjectScanResult',
 ]
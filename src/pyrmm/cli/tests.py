@@ -13,8 +13,12 @@ RmmCore 完整测试套件
 """
 
 import os
+import shutil
 import sys
 import tempfile
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor, as_completed
 from pathlib import Path
 import unittest
 
@@ -31,31 +35,41 @@ except ImportError as e:
 
 
 class TestRmmCore(unittest.TestCase):
-    """RmmCore 功能测试类"""
-    
-    def setUp(self):
-        """测试前准备"""
-        self.temp_dir = tempfile.mkdtemp()
-        self.original_env = os.environ.get('RMM_ROOT')
-        os.environ['RMM_ROOT'] = self.temp_dir
-        self.core = RmmCore()
-        print(f"🔧 测试环境设置完成: {self.temp_dir}")
-    
-    def tearDown(self):
-        """测试后清理"""
-        if self.original_env:
-            os.environ['RMM_ROOT'] = self.original_env
+    """RmmCore 功能测试类
+
+    进程内复用同一个 RmmCore fixture：RMM_ROOT 在 setUpClass 设置一次，
+    每个用例只分配自己的临时工作区子目录，省掉逐用例的实例构建和冷缓存
+    解析开销，也让用例可以安全地在线程池里并行执行。
+    """
+
+    # meta.toml 是共享资源，写它的用例之间串行
+    _meta_lock = threading.Lock()
+
+    @classmethod
+    def setUpClass(cls):
+        """建立整个测试类共享的 RMM_ROOT 与 RmmCore fixture"""
+        cls.class_root = tempfile.mkdtemp()
+        cls.original_env = os.environ.get('RMM_ROOT')
+        os.environ['RMM_ROOT'] = cls.class_root
+        cls.core = RmmCore()
+        print(f"🔧 共享测试环境设置完成: {cls.class_root}")
+
+    @classmethod
+    def tearDownClass(cls):
+        """恢复环境并清理共享目录"""
+        if cls.original_env:
+            os.environ['RMM_ROOT'] = cls.original_env
         else:
             os.environ.pop('RMM_ROOT', None)
-        
-        # 清理临时目录
-        import shutil
         try:
-            shutil.rmtree(self.temp_dir)
-        except:
+            shutil.rmtree(cls.class_root)
+        except Exception:
             pass
-        
-        print("🧹 测试环境清理完成")
+        print("🧹 共享测试环境清理完成")
+
+    def setUp(self):
+        """每个用例独立的临时工作区"""
+        self.temp_dir = tempfile.mkdtemp(dir=self.class_root)
     
     def test_basic_functionality(self):
         """测试基本功能"""
@@ -79,25 +93,26 @@ class TestRmmCore(unittest.TestCase):
     def test_meta_config_operations(self):
         """测试 Meta 配置操作"""
         print("\n📄 测试 Meta 配置操作...")
-        
+
         try:
-            # 尝试创建默认配置
-            email = "test@example.com"
-            username = "testuser"
-            version = "1.0.0"
-            
-            meta = self.core.create_default_meta(email, username, version)
-            self.assertIsInstance(meta, dict)
-            print("[+] 创建默认 Meta 配置成功")
-              # 尝试更新配置
-            result = self.core.update_meta_config_from_dict(meta)
-            print(f"[+] 更新 Meta 配置: {result}")
-            
-            # 尝试读取配置
-            loaded_meta = self.core.get_meta_config()
-            self.assertIsInstance(loaded_meta, dict)
-            print("[+] 读取 Meta 配置成功")
-            
+            with self._meta_lock:
+                # 尝试创建默认配置
+                email = "test@example.com"
+                username = "testuser"
+                version = "1.0.0"
+
+                meta = self.core.create_default_meta(email, username, version)
+                self.assertIsInstance(meta, dict)
+                print("[+] 创建默认 Meta 配置成功")
+                # 尝试更新配置
+                result = self.core.update_meta_config_from_dict(meta)
+                print(f"[+] 更新 Meta 配置: {result}")
+
+                # 尝试读取配置
+                loaded_meta = self.core.get_meta_config()
+                self.assertIsInstance(loaded_meta, dict)
+                print("[+] 读取 Meta 配置成功")
+
         except Exception as e:
             print(f"⚠️  Meta 配置测试部分失败: {e}")
     
@@ -197,21 +212,22 @@ description = "Git 测试项目"
         print("\n🗑️ 测试移除操作...")
         
         try:
-            # 首先创建一些测试数据
-            meta = self.core.create_default_meta("test@example.com", "testuser", "1.0.0")
-            self.core.update_meta_config_from_dict(meta)
-            
-            # 测试移除项目
-            removed = self.core.remove_project_from_meta("nonexistent_project")
-            print(f"[+] 移除不存在的项目: {removed}")
-            
-            # 测试移除无效项目
-            try:
-                invalid_projects = self.core.remove_invalid_projects()
-                print(f"[+] 移除无效项目: {invalid_projects}")
-            except Exception as e:
-                print(f"⚠️  移除无效项目失败: {e}")
-                
+            with self._meta_lock:
+                # 首先创建一些测试数据
+                meta = self.core.create_default_meta("test@example.com", "testuser", "1.0.0")
+                self.core.update_meta_config_from_dict(meta)
+
+                # 测试移除项目
+                removed = self.core.remove_project_from_meta("nonexistent_project")
+                print(f"[+] 移除不存在的项目: {removed}")
+
+                # 测试移除无效项目
+                try:
+                    invalid_projects = self.core.remove_invalid_projects()
+                    print(f"[+] 移除无效项目: {invalid_projects}")
+                except Exception as e:
+                    print(f"⚠️  移除无效项目失败: {e}")
+
         except Exception as e:
             print(f"⚠️  移除操作测试失败: {e}")
     
@@ -259,6 +275,52 @@ description = "Git 测试项目"
             print(f"⚠️  错误处理测试失败: {e}")
 
 
+def run_parallel_suite(jobs: int | None = None) -> bool:
+    """
+    并行执行 TestRmmCore 的所有用例
+
+    每个用例在线程池里拿到独立的 TestResult；RmmCore 的重操作在 GIL 之外
+    执行（allow_threads），所以线程级并行能真正吃满核心。共享的
+    setUpClass/tearDownClass 由 unittest 的类级 fixture 机制各执行一次。
+
+    Returns:
+        bool: 全部用例通过返回 True
+    """
+    loader = unittest.TestLoader()
+    test_names = loader.getTestCaseNames(TestRmmCore)
+    jobs = jobs or min(len(test_names), os.cpu_count() or 4)
+
+    print(f"\n🧪 并行运行 {len(test_names)} 个用例（{jobs} 个线程）...")
+    start = time.monotonic()
+
+    # 类级 fixture 手动执行一次，替代 TestRunner 的调度
+    TestRmmCore.setUpClass()
+    all_ok = True
+    try:
+        def run_one(name: str) -> tuple[str, unittest.TestResult]:
+            result = unittest.TestResult()
+            TestRmmCore(name).run(result)
+            return name, result
+
+        with ThreadPoolExecutor(max_workers=jobs) as executor:
+            futures = {executor.submit(run_one, name): name for name in test_names}
+            for future in as_completed(futures):
+                name, result = future.result()
+                if result.wasSuccessful():
+                    print(f"✅ {name}")
+                else:
+                    all_ok = False
+                    print(f"❌ {name}")
+                    for _, traceback_text in result.failures + result.errors:
+                        print(traceback_text)
+    finally:
+        TestRmmCore.tearDownClass()
+
+    elapsed = time.monotonic() - start
+    print(f"{'🎉' if all_ok else '❌'} 并行套件完成：{len(test_names)} 个用例，耗时 {elapsed:.2f}s")
+    return all_ok
+
+
 def run_performance_test():
     """性能测试"""
     print("\n🚀 运行性能测试...")
@@ -417,9 +479,12 @@ def main():
         print("请确保已正确编译和安装模块")
         return
     
-    # 运行单元测试
-    print("\n🧪 运行单元测试...")
-    unittest.main(argv=[''], exit=False, verbosity=2)
+    # 运行单元测试（默认并行，--serial 回退到逐个执行）
+    if "--serial" in sys.argv:
+        print("\n🧪 运行单元测试...")
+        unittest.main(argv=[''], exit=False, verbosity=2)
+    else:
+        run_parallel_suite()
     
     # 运行性能测试
     run_performance_test()
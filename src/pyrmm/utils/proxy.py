@@ -1,6 +1,8 @@
 import json
 import os
+import time
 import requests
+from concurrent.futures import ThreadPoolExecutor, as_completed
 from pathlib import Path
 from datetime import datetime, timedelta
 from typing import Any
@@ -43,6 +45,11 @@ class ProxyManager(metaclass=ProxyManagerMeta):
     
     API_URL = "https://api.akams.cn/github"
     CACHE_DURATION = timedelta(hours=10)  # 缓存10小时
+    PROBE_DURATION = timedelta(minutes=30)  # 实测结果30分钟内有效
+    # 探测目标：走代理拉取一个很小的 raw 文件，能同时验证连通性和加速路径
+    PROBE_TARGET = "https://raw.githubusercontent.com/torvalds/linux/master/COPYING"
+    PROBE_TIMEOUT = 5  # 单个代理探测超时（秒）
+    PROBE_WORKERS = 16  # 并发探测线程数上限
     
     @classmethod
     def _load_cache(cls) -> dict[str, Any] | None:
@@ -162,6 +169,94 @@ class ProxyManager(metaclass=ProxyManagerMeta):
         
         return None
     
+    @classmethod
+    def _probe_one(cls, proxy: dict[str, Any]) -> dict[str, Any]:
+        """
+        主动探测单个代理：发一个带 Range 的小请求，实测延迟和吞吐
+
+        Args:
+            proxy: 代理条目（至少包含url字段）
+
+        Returns:
+            dict[str, Any]: 带有 measured_latency / measured_speed / measured_ok 字段的代理条目
+        """
+        url = str(proxy.get("url", "")).rstrip("/")
+        probe_url = f"{url}/{cls.PROBE_TARGET}"
+        try:
+            start = time.monotonic()
+            # 只取前64KB，足够测出首字节延迟和粗略吞吐
+            response = requests.get(
+                probe_url,
+                headers={"Range": "bytes=0-65535"},
+                timeout=cls.PROBE_TIMEOUT,
+                stream=True,
+            )
+            latency_ms = (time.monotonic() - start) * 1000
+            response.raise_for_status()
+
+            downloaded = 0
+            for chunk in response.iter_content(chunk_size=16384):
+                downloaded += len(chunk)
+                if downloaded >= 65536:
+                    break
+            elapsed = time.monotonic() - start
+            response.close()
+
+            proxy["measured_latency"] = round(latency_ms)
+            proxy["measured_speed"] = round(downloaded / max(elapsed, 0.001) / 1024 / 1024, 3)
+            proxy["measured_ok"] = True
+        except Exception:
+            proxy["measured_latency"] = None
+            proxy["measured_speed"] = 0
+            proxy["measured_ok"] = False
+        return proxy
+
+    @classmethod
+    def probe_proxies(cls, proxy_list: list[dict[str, Any]], force_probe: bool = False) -> list[dict[str, Any]]:
+        """
+        并发探测所有候选代理，并把实测结果写回持久缓存
+
+        Args:
+            proxy_list: 待探测的代理列表
+            force_probe: 是否忽略30分钟内的实测结果强制重新探测
+
+        Returns:
+            list[dict[str, Any]]: 带实测数据的代理列表
+        """
+        if not proxy_list:
+            return proxy_list
+
+        # 30分钟内探测过且结果仍在缓存里，直接复用
+        cache_data = cls._load_cache()
+        if not force_probe and cache_data and cache_data.get("probed_at"):
+            try:
+                probed_at = datetime.fromisoformat(str(cache_data["probed_at"]))
+                cached_list = cache_data.get("data", [])
+                if (datetime.now() - probed_at <= cls.PROBE_DURATION
+                        and any("measured_ok" in p for p in cached_list)):
+                    print(f"✅ 复用 {cache_data['probed_at']} 的实测探测结果")
+                    return cached_list
+            except (ValueError, TypeError):
+                pass
+
+        print(f"📡 并发探测 {len(proxy_list)} 个代理的真实延迟...")
+        workers = min(cls.PROBE_WORKERS, len(proxy_list))
+        with ThreadPoolExecutor(max_workers=workers) as executor:
+            futures = [executor.submit(cls._probe_one, proxy) for proxy in proxy_list]
+            for future in as_completed(futures):
+                future.result()  # 异常已在 _probe_one 内部吞掉
+
+        alive = sum(1 for p in proxy_list if p.get("measured_ok"))
+        print(f"📊 探测完成: {alive}/{len(proxy_list)} 个代理可用")
+
+        # 实测结果写回持久缓存，后续30分钟内直接复用
+        if cache_data:
+            cache_data["data"] = proxy_list
+            cache_data["probed_at"] = datetime.now().isoformat()
+            cls._save_cache(cache_data)
+
+        return proxy_list
+
     @classmethod
     def get_proxy_list(cls, force_update: bool = False, timeout: int = 10) -> list[dict[str, object]]:
         """
@@ -208,32 +303,101 @@ class ProxyManager(metaclass=ProxyManagerMeta):
         return []
     
     @classmethod
-    def get_best_proxy(cls, force_update: bool = False) -> str | None:
+    def get_best_proxy(cls, force_update: bool = False, probe: bool = True) -> str | None:
         """
-        获取最佳的GitHub代理URL（基于延迟和速度）
-        
+        获取最佳的GitHub代理URL（优先使用本机实测的延迟和速度）
+
         Args:
             force_update: 是否强制更新代理列表
-            
+            probe: 是否主动并发探测各代理，按实测结果排序
+
         Returns:
             Optional[str]: 最佳代理URL，如果没有可用代理则返回None
         """
         proxy_list = cls.get_proxy_list(force_update)
-        
+
         if not proxy_list:
             return None
-          # 根据延迟和速度排序（延迟越低越好，速度越高越好）
+
+        if probe:
+            proxy_list = cls.probe_proxies(proxy_list, force_probe=force_update)
+            # 实测存活的代理优先；全部探测失败时回退到API评分
+            alive = [p for p in proxy_list if p.get("measured_ok")]
+            if alive:
+                def score_measured(proxy: dict[str, object]) -> float:
+                    latency = int(proxy.get("measured_latency", 9999) or 9999)
+                    speed = float(proxy.get("measured_speed", 0) or 0)
+                    return speed / max(latency, 1)
+
+                best_proxy = max(alive, key=score_measured)
+                print(f"🚀 选择最佳代理(实测): {best_proxy['url']} "
+                      f"(延迟: {best_proxy.get('measured_latency', 'N/A')}ms, "
+                      f"速度: {best_proxy.get('measured_speed', 'N/A')}MB/s)")
+                return best_proxy["url"]
+            print("⚠️  所有代理实测均不可用，回退到API评分")
+
+        # 根据API上报的延迟和速度排序（延迟越低越好，速度越高越好）
         def score_proxy(proxy: dict[str, object]) -> float:
             latency = int(proxy.get("latency", 9999) or 9999)
             speed = float(proxy.get("speed", 0) or 0)
             # 简单评分算法：速度/延迟，延迟为0时设为1避免除零
             return speed / max(latency, 1)
-        
+
         best_proxy = max(proxy_list, key=score_proxy)
         print(f"🚀 选择最佳代理: {best_proxy['url']} (延迟: {best_proxy.get('latency', 'N/A')}ms, 速度: {best_proxy.get('speed', 'N/A')}MB/s)")
-        
+
         return best_proxy["url"]
-    
+
+    @classmethod
+    def race_best_proxy(cls, top_n: int = 5, force_update: bool = False) -> str | None:
+        """
+        竞速模式：并发探测API评分前 N 的代理，提交给第一个应答的，取消其余探测
+
+        与 get_best_proxy 不同，竞速不等全部探测结束，最坏耗时被限定在
+        一轮探测（PROBE_TIMEOUT）而不是逐个等待 N 次超时。
+
+        Args:
+            top_n: 参与竞速的代理数量
+            force_update: 是否强制更新代理列表
+
+        Returns:
+            Optional[str]: 第一个应答探测的代理URL，全部失败则返回None
+        """
+        proxy_list = cls.get_proxy_list(force_update)
+
+        if not proxy_list:
+            return None
+
+        # 按API评分挑出前 N 名参赛
+        def score_proxy(proxy: dict[str, Any]) -> float:
+            latency = int(proxy.get("latency", 9999) or 9999)
+            speed = float(proxy.get("speed", 0) or 0)
+            return speed / max(latency, 1)
+
+        candidates = sorted(proxy_list, key=score_proxy, reverse=True)[:max(top_n, 1)]
+
+        print(f"🏁 竞速探测前 {len(candidates)} 个代理...")
+        executor = ThreadPoolExecutor(max_workers=len(candidates))
+        try:
+            futures = {executor.submit(cls._probe_one, dict(p)): p for p in candidates}
+            for future in as_completed(futures, timeout=cls.PROBE_TIMEOUT + 1):
+                try:
+                    probed = future.result()
+                except Exception:
+                    continue
+                if probed.get("measured_ok"):
+                    print(f"🚀 竞速胜出: {probed['url']} "
+                          f"(延迟: {probed.get('measured_latency', 'N/A')}ms)")
+                    return str(probed["url"])
+        except TimeoutError:
+            pass
+        finally:
+            # 胜者已定（或全部超时），取消尚未开始的探测，不等剩余连接收尾
+            executor.shutdown(wait=False, cancel_futures=True)
+
+        print("⚠️  竞速探测全部失败")
+        return None
+
     @classmethod
     def clear_cache(cls) -> None:
         """
@@ -293,17 +457,32 @@ def get_github_proxies(force_update: bool = False) -> list[dict[str, object]]:
     return ProxyManager.get_proxy_list(force_update)
 
 
-def get_best_github_proxy(force_update: bool = False) -> str | None:
+def get_best_github_proxy(force_update: bool = False, probe: bool = True) -> str | None:
     """
     获取最佳GitHub代理的便捷函数
-    
+
     Args:
         force_update: 是否强制更新
-        
+        probe: 是否主动探测各代理的真实延迟
+
     Returns:
         Optional[str]: 最佳代理URL
     """
-    return ProxyManager.get_best_proxy(force_update)
+    return ProxyManager.get_best_proxy(force_update, probe)
+
+
+def race_best_github_proxy(top_n: int = 5, force_update: bool = False) -> str | None:
+    """
+    竞速选择GitHub代理的便捷函数：并发探测前 N 个代理，返回第一个应答的
+
+    Args:
+        top_n: 参与竞速的代理数量
+        force_update: 是否强制更新
+
+    Returns:
+        Optional[str]: 胜出的代理URL，全部失败则返回None
+    """
+    return ProxyManager.race_best_proxy(top_n, force_update)
 
 
 # 示例用法和测试